@@ -0,0 +1,72 @@
+#include<iostream>
+#include<iomanip>
+#include<vector>
+#include<string>
+#include<random>
+#include<chrono>
+#include<thread>
+#include<cmath>
+#include<algorithm>
+
+#include<include/BigInt.h>
+
+//乘法的多线程扩展性测试：同一个乘积依次用1, 2, 4, ..., N个线程计算
+//用法: BigIntBench [最大线程数] [十进制位数...]
+//默认线程数为硬件线程数，位数为1000000和10000000；100000000位的乘积需要约1GB内存
+static BigInt randomDigits(uint64_t digits, std::mt19937_64& rng) {
+	//十六进制位数按等价的二进制长度换算，最高位不为0
+	uint64_t hex_digits = static_cast<uint64_t>(std::ceil(digits * std::log2(10.0) / 4));
+	std::string hex(hex_digits, '0');
+	for (char& c : hex) c = "0123456789abcdef"[rng() % 16];
+	hex[0] = "123456789abcdef"[rng() % 15];
+	return util::from_string(hex, 16);
+}
+
+static double seconds(const std::chrono::steady_clock::time_point& start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+	uint32_t max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+	std::vector<uint64_t> sizes;
+	if (argc > 1) max_threads = static_cast<uint32_t>(std::stoul(argv[1]));
+	for (int i = 2; i < argc; ++i) sizes.push_back(std::stoull(argv[i]));
+	if (sizes.empty()) sizes = { 1000000, 10000000 };
+	std::vector<uint32_t> thread_counts;
+	for (uint32_t t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+	thread_counts.push_back(max_threads);
+
+	const uint32_t threshold = util::parallel_config().threshold;
+	std::mt19937_64 rng{ 20240601 };
+	std::cout << "digits      threads  seconds    speedup  efficiency\n";
+	for (uint64_t digits : sizes) {
+		BigInt a = randomDigits(digits, rng), b = randomDigits(digits, rng);
+		BigInt expected;
+		double serial{ 0 };
+		for (uint32_t threads : thread_counts) {
+			util::set_parallel_config({ threads, threshold });
+			//较小的规模取3次中最快的一次
+			int runs = digits <= 10000000 ? 3 : 1;
+			double best{ 0 };
+			BigInt product;
+			for (int run = 0; run < runs; ++run) {
+				auto start = std::chrono::steady_clock::now();
+				product = a * b;
+				double t = seconds(start);
+				if (run == 0 || t < best) best = t;
+			}
+			if (threads == 1) {
+				serial = best;
+				expected = std::move(product);
+			}
+			else if (product != expected) {
+				std::cerr << "result with " << threads << " threads differs from the serial result\n";
+				return 1;
+			}
+			std::cout << std::left << std::setw(12) << digits << std::setw(9) << threads << std::fixed << std::setprecision(3)
+				<< std::setw(11) << best << std::setw(9) << serial / best << std::setprecision(2) << serial / best / threads << "\n";
+		}
+	}
+	util::set_parallel_config({ 1, threshold });
+	return 0;
+}
@@ -1,3 +1,8 @@
 #pragma once
 #include<src/BigInt_impl.h>
-#include<src/Util.h>
\ No newline at end of file
+#include<src/Util.h>
+#include<src/Serialize.h>
+#include<src/Arena.h>
+#include<src/SharedBigInt.h>
+#include<src/Batch.h>
+#include<src/Modulus.h>
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include<memory_resource>
+#include<cstddef>
+
+//请求级别的内存池：析构的BigInt把limb还给池子供后续的临时值复用，release()把全部内存一次性归还
+//不是线程安全的，每个线程使用自己的arena；从arena分配的BigInt必须在release()或arena析构之前析构
+class BigIntArena : public std::pmr::memory_resource {
+public:
+	BigIntArena() = default;
+	//先使用调用者提供的缓冲区(比如栈上的数组)，用完后再向上游申请
+	BigIntArena(void* initial_buffer, size_t size) :_monotonic{ initial_buffer, size } {}
+	BigIntArena(const BigIntArena&) = delete;
+	BigIntArena& operator=(const BigIntArena&) = delete;
+
+	void release() {
+		_pool.release();
+		_monotonic.release();
+	}
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		return _pool.allocate(bytes, alignment);
+	}
+	void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+		_pool.deallocate(p, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+	std::pmr::monotonic_buffer_resource _monotonic;
+	std::pmr::unsynchronized_pool_resource _pool{ &_monotonic };
+};
@@ -0,0 +1,187 @@
+#include<algorithm>
+#include<functional>
+#include<vector>
+
+#include"src/Batch.h"
+#include"src/Limbs.h"
+
+//每个任务至少处理的元素个数，太小的块在线程间调度的开销超过计算本身
+constexpr size_t batch_grain = 256;
+
+static uint32_t chunkCount(size_t n, size_t grain) {
+	return static_cast<uint32_t>(std::min<size_t>(limbs::parallelThreads(), (n + grain - 1) / grain));
+}
+
+//把[0, n)分成chunkCount块，每块调用一次task(块号, first, last)
+static void forEachChunk(size_t n, size_t grain, const std::function<void(uint32_t, size_t, size_t)>& task) {
+	uint32_t chunks = chunkCount(n, grain);
+	if (chunks <= 1) {
+		task(0, 0, n);
+		return;
+	}
+	limbs::parallelFor(chunks, [&](uint32_t c) {
+		task(c, n * c / chunks, n * (c + 1) / chunks);
+	});
+}
+
+//只有会并行、并且输出使用自己的资源时才需要；全局的new/delete本身是线程安全的
+void batch::reserveOutputs(BigInt* out, size_t n, const std::function<uint32_t(size_t)>& cap) {
+	if (chunkCount(n, batch_grain) <= 1) return;
+	for (size_t i = 0; i < n; ++i) {
+		if (out[i]._resource == nullptr) continue;
+		uint32_t c = cap(i);
+		if (c == 0) out[i].free();
+		else out[i].reserve(c);
+	}
+}
+
+//add, sub的结果至多多出一个limb
+static uint32_t addCap(const BigInt& l, const BigInt& r) {
+	return l.isNaN() || r.isNaN() ? 0 : std::max(l._size, r._size) + 1;
+}
+
+static uint32_t mulCap(const BigInt& l, const BigInt& r) {
+	if (l.isNaN() || r.isNaN()) return 0;
+	if (l._size <= 1 || r._size <= 1) return std::max(l._size, r._size) + 1;
+	return l._size + r._size;
+}
+
+//out可以就是l或r，reserve之后再读取它们的limb
+void batch::addTo(BigInt& out, const BigInt& l, const BigInt& r, bool subtract) {
+	if (l.isNaN() || r.isNaN()) {
+		out.free();
+		return;
+	}
+	bool r_sign{ r._sign != subtract };
+	if (l._sign == r_sign) {
+		const BigInt& longer = l._size >= r._size ? l : r;
+		const BigInt& shorter = l._size >= r._size ? r : l;
+		uint32_t size{ longer._size };
+		out.reserve(size + 1);
+		BigInt::limb_t carry = limbs::add(out._limbs, longer._limbs, size, shorter._limbs, shorter._size);
+		out._size = size;
+		if (carry) out._limbs[out._size++] = carry;
+		out._sign = l._sign;
+	}
+	else {
+		bool l_greater = limbs::compare(l._limbs, l._size, r._limbs, r._size) >= 0;
+		const BigInt& greater = l_greater ? l : r;
+		const BigInt& less = l_greater ? r : l;
+		uint32_t size{ greater._size };
+		out.reserve(size);
+		limbs::sub(out._limbs, greater._limbs, size, less._limbs, less._size);
+		out._size = size;
+		out._sign = l_greater ? l._sign : r_sign;
+	}
+	out.normalize();
+}
+
+void batch::mulTo(BigInt& out, const BigInt& l, const BigInt& r) {
+	if (l.isNaN() || r.isNaN()) {
+		out.free();
+		return;
+	}
+	bool sign{ l._sign == r._sign };
+	if (l._size <= 1 || r._size <= 1) {
+		//单limb的乘数先取出来，out与另一个操作数相同时原地相乘
+		const BigInt& other = l._size <= 1 ? r : l;
+		const BigInt& single = l._size <= 1 ? l : r;
+		BigInt::limb_t m{ single._size == 0 ? 0 : single._limbs[0] };
+		uint32_t size{ other._size };
+		out.reserve(size + 1);
+		BigInt::limb_t carry = limbs::mulBySingle(out._limbs, other._limbs, size, m);
+		out._size = size;
+		if (carry) out._limbs[out._size++] = carry;
+	}
+	else if (&out == &l || &out == &r) {
+		//乘法的结果不能与操作数重叠，先写到全局分配的临时空间再复制回来
+		std::vector<BigInt::limb_t> product(l._size + r._size);
+		limbs::mul(product.data(), l._limbs, l._size, r._limbs, r._size);
+		out.reserve(static_cast<uint32_t>(product.size()));
+		std::copy(product.begin(), product.end(), out._limbs);
+		out._size = static_cast<uint32_t>(product.size());
+	}
+	else {
+		out.reserve(l._size + r._size);
+		limbs::mul(out._limbs, l._limbs, l._size, r._limbs, r._size);
+		out._size = l._size + r._size;
+	}
+	out._sign = sign;
+	out.normalize();
+}
+
+void batch::add(const BigInt* l, const BigInt* r, BigInt* out, size_t n) {
+	reserveOutputs(out, n, [&](size_t i) { return addCap(l[i], r[i]); });
+	forEachChunk(n, batch_grain, [&](uint32_t, size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) addTo(out[i], l[i], r[i], false);
+	});
+}
+
+void batch::sub(const BigInt* l, const BigInt* r, BigInt* out, size_t n) {
+	reserveOutputs(out, n, [&](size_t i) { return addCap(l[i], r[i]); });
+	forEachChunk(n, batch_grain, [&](uint32_t, size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) addTo(out[i], l[i], r[i], true);
+	});
+}
+
+void batch::mul(const BigInt* l, const BigInt* r, BigInt* out, size_t n) {
+	reserveOutputs(out, n, [&](size_t i) { return mulCap(l[i], r[i]); });
+	forEachChunk(n, batch_grain, [&](uint32_t, size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) mulTo(out[i], l[i], r[i]);
+	});
+}
+
+void batch::mul_scalar(const BigInt* l, const BigInt& scalar, BigInt* out, size_t n) {
+	//scalar可能是out中的元素，先复制一份
+	BigInt s(scalar);
+	reserveOutputs(out, n, [&](size_t i) { return mulCap(l[i], s); });
+	forEachChunk(n, batch_grain, [&](uint32_t, size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) mulTo(out[i], l[i], s);
+	});
+}
+
+void batch::compare(const BigInt* l, const BigInt* r, int* out, size_t n) {
+	forEachChunk(n, batch_grain, [&](uint32_t, size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) out[i] = l[i].compare(r[i]);
+	});
+}
+
+BigInt batch::sum(const BigInt* v, size_t n) {
+	if (n == 0) return BigInt(0);
+	//每块先各自累加，最后把各块的部分和加起来
+	std::vector<BigInt> partial(std::max(chunkCount(n, batch_grain), 1u));
+	forEachChunk(n, batch_grain, [&](uint32_t c, size_t first, size_t last) {
+		BigInt& acc = partial[c];
+		acc = v[first];
+		for (size_t i = first + 1; i < last; ++i) acc += v[i];
+	});
+	BigInt ret(std::move(partial[0]));
+	for (size_t c = 1; c < partial.size(); ++c) ret += partial[c];
+	return ret;
+}
+
+BigInt batch::product(const BigInt* v, size_t n) {
+	if (n == 0) return BigInt(1);
+	//第一层直接读输入，之后每层把相邻的两个乘起来，长度减半
+	std::vector<BigInt> level((n + 1) / 2);
+	size_t grain{ batch_grain };
+	forEachChunk(level.size(), grain, [&](uint32_t, size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i) {
+			if (2 * i + 1 < n) mulTo(level[i], v[2 * i], v[2 * i + 1]);
+			else level[i] = v[2 * i];
+		}
+	});
+	while (level.size() > 1) {
+		//每上一层乘数长度翻倍，basecase乘法的代价约为4倍，块可以相应地缩小
+		grain = std::max<size_t>(grain / 4, 1);
+		std::vector<BigInt> next((level.size() + 1) / 2);
+		forEachChunk(next.size(), grain, [&](uint32_t, size_t first, size_t last) {
+			for (size_t i = first; i < last; ++i) {
+				if (2 * i + 1 < level.size()) mulTo(next[i], level[2 * i], level[2 * i + 1]);
+				else next[i] = std::move(level[2 * i]);
+			}
+		});
+		level = std::move(next);
+	}
+	return std::move(level[0]);
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include<src/BigInt_impl.h>
+#include<cstddef>
+#include<functional>
+
+//对整列BigInt做同一种运算，数组以指针和长度传入(vector、array都可以)
+//out[i]已有的缓冲区足够时直接写入，不再分配；out可以与l或r是同一个数组
+//元素很多且打开了并行(util::set_parallel_config)时按块分给线程池
+//输出的内存资源不必是线程安全的(比如BigIntArena)：并行之前先在调用线程上为这些输出预留好空间，工作线程不再从中分配或释放
+class batch {
+public:
+	//out[i] = l[i] + r[i]
+	static void add(const BigInt* l, const BigInt* r, BigInt* out, size_t n);
+	//out[i] = l[i] - r[i]
+	static void sub(const BigInt* l, const BigInt* r, BigInt* out, size_t n);
+	//out[i] = l[i] * r[i]
+	static void mul(const BigInt* l, const BigInt* r, BigInt* out, size_t n);
+	//out[i] = l[i] * scalar，scalar只有一个limb时原地相乘
+	static void mul_scalar(const BigInt* l, const BigInt& scalar, BigInt* out, size_t n);
+	//out[i] = l[i].compare(r[i])
+	static void compare(const BigInt* l, const BigInt* r, int* out, size_t n);
+	//空数组的和为0，任何一个元素是NaN时结果为NaN
+	static BigInt sum(const BigInt* v, size_t n);
+	//两两相乘的乘积树，让每一层的乘数大小接近；空数组的积为1
+	static BigInt product(const BigInt* v, size_t n);
+private:
+	//cap(i)是out[i]需要的limb个数，0表示结果是NaN
+	static void reserveOutputs(BigInt* out, size_t n, const std::function<uint32_t(size_t)>& cap);
+	static void addTo(BigInt& out, const BigInt& l, const BigInt& r, bool subtract);
+	static void mulTo(BigInt& out, const BigInt& l, const BigInt& r);
+};
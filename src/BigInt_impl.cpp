@@ -6,80 +6,81 @@
 #include<vector>
 #include<complex>
 #include<string_view>
+#include<stdexcept>
+#include<cmath>
+#include<algorithm>
+#include<atomic>
+#include<memory>
 
 #include"src/BigInt_impl.h"
+#include"src/Limbs.h"
 #include"src/Util.h"
 
 //friend declear
 API BigInt operator+(const BigInt& l, const BigInt& r);
+API BigInt operator+(BigInt&& l, const BigInt& r);
+API BigInt operator+(const BigInt& l, BigInt&& r);
+API BigInt operator+(BigInt&& l, BigInt&& r);
 API BigInt operator-(const BigInt& l, const BigInt& r);
+API BigInt operator-(BigInt&& l, const BigInt& r);
+API BigInt operator-(const BigInt& l, BigInt&& r);
+API BigInt operator-(BigInt&& l, BigInt&& r);
 API BigInt operator*(const BigInt& l, const BigInt& r);
 API BigInt operator/(const BigInt& l, const BigInt& r);
 API BigInt operator%(const BigInt& l, const BigInt& r);
+API BigInt operator<<(const BigInt& l, uint64_t shift);
+API BigInt operator>>(const BigInt& l, uint64_t shift);
+API BigInt operator&(const BigInt& l, const BigInt& r);
+API BigInt operator|(const BigInt& l, const BigInt& r);
+API BigInt operator^(const BigInt& l, const BigInt& r);
 
 API bool operator>(const BigInt& l, const BigInt& r);
 API bool operator==(const BigInt& l, const BigInt& r);
+API bool operator!=(const BigInt& l, const BigInt& r);
 API bool operator>=(const BigInt& l, const BigInt& r);
 API bool operator<(const BigInt& l, const BigInt& r);
 API bool operator<=(const BigInt& l, const BigInt& r);
 
-API std::ostream& operator<<(std::ostream& o, BigInt& bInt);
+API std::ostream& operator<<(std::ostream& o, const BigInt& bInt);
 API std::istream& operator>>(std::istream& i, BigInt& bInt);
 
+//堆分配计数，用于确认小整数运算不会触碰堆
+static std::atomic<uint64_t> heap_allocations{ 0 };
+
 //implementation
-API BigInt::BigInt(const BigInt& in) {
-	size_t sz = in._end - in._digits;
-	_digits = new char[sz];
-	_end = _digits + sz;
-	memcpy((void*)_digits, (const void*)in._digits, sz);
-	_sign = in._sign;
+//与std::pmr的容器一致，拷贝使用默认资源，只有移动保留原来的资源
+API BigInt::BigInt(const BigInt& in) : BigInt(in, std::pmr::get_default_resource()) {}
+
+API BigInt::BigInt(std::pmr::memory_resource* resource) {
+	_resource = resource == std::pmr::new_delete_resource() ? nullptr : resource;
 }
 
-API BigInt::BigInt(BigInt&& in) {
-	_digits = in._digits;
-	_end = in._end;
-	_sign = in._sign;
-	in._digits = nullptr;
-	in._end = nullptr;
+API BigInt::BigInt(const BigInt& in, std::pmr::memory_resource* resource) : BigInt(resource) {
+	if (!in.isNaN()) {
+		reserve(in._size);
+		memcpy((void*)_limbs, (const void*)in._limbs, in._size * sizeof(limb_t));
+		_size = in._size;
+		_sign = in._sign;
+	}
+}
+
+API BigInt::BigInt(BigInt&& in) : _resource{ in._resource } {
+	steal(in);
 }
 
 API BigInt::BigInt(const std::string& str_in) {
-	if (isValidString(str_in)) {
-		size_t alloc_sz = str_in.size();
-		if (str_in.front() == '-') {
-			--alloc_sz;
-			_sign = false;
-		}
-		_digits = new char[alloc_sz];
-		_end = _digits + alloc_sz;
-		memcpy((void*)_digits, (const void*)(str_in.data() + !_sign), alloc_sz);
-	}
+	const char* last = str_in.data() + str_in.size();
+	if (parse(str_in.data(), last, 10) != last) free();
 }
 
 API BigInt::BigInt(const std::string_view& str_v) {
-	if (isValidString(str_v)) {
-		size_t alloc_sz = str_v.size();
-		if (str_v[0] == '-') {
-			--alloc_sz;
-			_sign = false;
-		}
-		_digits = new char[alloc_sz];
-		_end = _digits + alloc_sz;
-		memcpy((void*)_digits, (const void*)(str_v.data() + !_sign), alloc_sz);
-	}
+	const char* last = str_v.data() + str_v.size();
+	if (parse(str_v.data(), last, 10) != last) free();
 }
 
 API BigInt::BigInt(const char* cstr_in) {
-	if (isValidString(std::string(cstr_in))) {
-		size_t len = strlen(cstr_in);
-		if (*cstr_in == '-') {
-			--len;
-			_sign = false;
-		}
-		_digits = new char[len];
-		_end = _digits + len;
-		memcpy((void*)_digits, (const void*)(cstr_in + !_sign), len);
-	}
+	const char* last = cstr_in + std::strlen(cstr_in);
+	if (parse(cstr_in, last, 10) != last) free();
 }
 
 API BigInt::~BigInt() {
@@ -87,84 +88,199 @@ API BigInt::~BigInt() {
 }
 
 API bool BigInt::isNaN() const {
-	return _digits == nullptr || _digits == _end;
+	return _limbs == nullptr;
+}
+
+API std::pmr::memory_resource* BigInt::resource() const {
+	return _resource ? _resource : std::pmr::new_delete_resource();
+}
+
+std::pmr::memory_resource* BigInt::resultResource(const BigInt& l, const BigInt& r) {
+	return l._resource ? l._resource : r._resource;
 }
 
 uint32_t BigInt::digits10() const {
-	return static_cast<uint32_t>(_end - _digits);
+	if (isNaN()) return 0;
+	return static_cast<uint32_t>(limbs::countDigits(_limbs, _size, 10));
 }
 
-bool BigInt::isValidString(const std::string_view& str) const {
-	int index{ 0 };
-	if (str[index] == '-') ++index;
-	while (index < str.size()) {
-		if (!(str[index] >= '0' && str[index] <= '9')) {
-			return false;
-		}
-		++index;
-	}
-	return true;
+//解析开头的radix进制整数，返回第一个未使用的字符，没有数字时返回first且不修改*this
+const char* BigInt::parse(const char* first, const char* last, int radix) {
+	const char* digits = first + (first != last && *first == '-');
+	const char* end = digits;
+	while (end != last && limbs::digitValue(*end) < radix) ++end;
+	if (end == digits) return first;
+	reserve(limbs::limbsForDigits(end - digits, radix));
+	_size = limbs::fromChars(_limbs, digits, end, radix);
+	_sign = digits == first;
+	normalize();
+	return end;
 }
 
 void BigInt::swap(BigInt& in) {
-	char* mid_digit = in._digits;
-	char* mid_end = in._end;
-	bool mid_sign = in._sign;
-	in._digits = _digits;
-	in._end = _end;
-	in._sign = _sign;
-	_digits = mid_digit;
-	_end = mid_end;
-	_sign = mid_sign;
+	if (this == &in) return;
+	//资源不同时移动赋值会退化为拷贝
+	BigInt temp(std::move(in));
+	in = std::move(*this);
+	*this = std::move(temp);
 }
 
 void BigInt::free() {
-	if (!isNaN()) delete[] _digits;
-	_digits = nullptr;
-	_end = nullptr;
+	if (!isNaN() && !isInline()) deallocate(_limbs, _cap);
+	_limbs = nullptr;
+	_size = 0;
+	_cap = 0;
 	_sign = true;
 }
 
-void BigInt::fft(std::vector<std::complex<double>>& ply, bool is_inverse) {
-	auto pi = 3.141592653589793238462643383279502884e+00;
-	int n = ply.size();
-	if (n == 1) {
+bool BigInt::isInline() const {
+	return _limbs == _inline;
+}
+
+void BigInt::reserve(uint32_t cap) {
+	if (!isNaN() && cap <= _cap) return;
+	if (isNaN() && cap <= inline_limbs) {
+		_limbs = _inline;
+		_cap = inline_limbs;
+		return;
+	}
+	//超出内联容量时按1.5倍增长，溢出到堆上
+	cap = std::max(cap, _cap + _cap / 2);
+	limb_t* limbs = allocate(cap);
+	if (!isNaN()) {
+		memcpy((void*)limbs, (const void*)_limbs, _size * sizeof(limb_t));
+		if (!isInline()) deallocate(_limbs, _cap);
+	}
+	_limbs = limbs;
+	_cap = cap;
+}
+
+BigInt::limb_t* BigInt::allocate(uint32_t cap) {
+	if (_resource) return static_cast<limb_t*>(_resource->allocate(cap * sizeof(limb_t), alignof(limb_t)));
+	heap_allocations.fetch_add(1, std::memory_order_relaxed);
+	return new limb_t[cap];
+}
+
+void BigInt::deallocate(limb_t* limbs, uint32_t cap) {
+	if (_resource) _resource->deallocate(limbs, cap * sizeof(limb_t), alignof(limb_t));
+	else delete[] limbs;
+}
+
+void BigInt::steal(BigInt& in) {
+	//内联存储只能拷贝，堆上的存储直接接管指针，调用者保证两者的资源相同
+	if (in.isInline()) {
+		memcpy((void*)_inline, (const void*)in._inline, in._size * sizeof(limb_t));
+		_limbs = _inline;
+	}
+	else {
+		_limbs = in._limbs;
+	}
+	_size = in._size;
+	_cap = in._cap;
+	_sign = in._sign;
+	in._limbs = nullptr;
+	in._size = 0;
+	in._cap = 0;
+	in._sign = true;
+}
+
+uint64_t BigInt::allocations() {
+	return heap_allocations.load(std::memory_order_relaxed);
+}
+
+void BigInt::normalize() {
+	_size = limbs::normalizedSize(_limbs, _size);
+	if (_size == 0) _sign = true;
+}
+
+void BigInt::assign(unsigned long long magnitude, bool sign) {
+	reserve(2);
+	_size = 0;
+	while (magnitude > 0) {
+		_limbs[_size++] = static_cast<limb_t>(magnitude);
+		magnitude >>= limbs::limb_bits;
+	}
+	_sign = sign;
+	normalize();
+}
+
+void BigInt::assign(double in) {
+	if (!std::isfinite(in)) return;
+	double din{ std::trunc(std::abs(in)) };
+	if (din < 18446744073709551616.0) {
+		assign(static_cast<unsigned long long>(din), in >= 0);
 		return;
 	}
-	int mid = n / 2;
-	std::vector<std::complex<double>> f1(mid, std::complex<double>());
-	std::vector<std::complex<double>> f2(mid, std::complex<double>());
-	for (int i = 0; i < mid; ++i) {
-		f1[i] = ply[2 * i];
-		f2[i] = ply[2 * i + 1];
-	}
-	fft(f1, is_inverse);
-	fft(f2, is_inverse);
-	std::complex<double> w0(1, 0), wn(std::cos((2 * pi) / n), (is_inverse ? -1 : 1) * std::sin((2 * pi) / n));
-	for (int i = 0; i < mid; ++i, w0 *= wn) {
-		ply[i] = f1[i] + w0 * f2[i];
-		ply[i + mid] = f1[i] - w0 * f2[i];
-	}
-}
-
-BigInt BigInt::multiBySingle(const BigInt& l, const char& single) {
-	if (single == '0') return BigInt(0);
-	std::string res(l.digits10() + 1, 0);
-	auto tail = res.end();
-	int carry{ 0 };
-	for (auto rbegin{ l._end }; rbegin != l._digits; --rbegin) {
-		int l_basic = *(rbegin - 1) - '0';
-		int r_basic = single - '0';
-		*(--tail) = ((l_basic * r_basic + carry) % 10) + '0';
-		carry = (l_basic * r_basic + carry) / 10;
-	}
-	if (carry > 0) {
-		*(--tail) = carry + '0';
-	}
-	int head = tail - res.begin();
-	std::string_view res_v(res.data() + head, res.size() - head);
-	BigInt ret(res_v);
+	//din = mantissa * 2^(exp - 53)，其中mantissa是53位整数
+	int exp;
+	unsigned long long mantissa = static_cast<unsigned long long>(std::ldexp(std::frexp(din, &exp), 53));
+	uint32_t shift = static_cast<uint32_t>(exp - 53);
+	uint32_t limb_shift = shift / limbs::limb_bits, bit_shift = shift % limbs::limb_bits;
+	reserve(limb_shift + 3);
+	memset((void*)_limbs, 0, (limb_shift + 3) * sizeof(limb_t));
+	_limbs[limb_shift] = static_cast<limb_t>(mantissa << bit_shift);
+	_limbs[limb_shift + 1] = static_cast<limb_t>(mantissa >> (limbs::limb_bits - bit_shift));
+	_limbs[limb_shift + 2] = bit_shift == 0 ? 0 : static_cast<limb_t>(mantissa >> (2 * limbs::limb_bits - bit_shift));
+	_size = limb_shift + 3;
+	_sign = in >= 0;
+	normalize();
+}
+
+std::string BigInt::toString(int radix) const {
+	if (isNaN()) return std::string();
+	std::string ret(limbs::digitsForLimbs(_size, radix), '\0');
+	ret.resize(write(ret.data(), ret.data() + ret.size(), radix) - ret.data());
+	return ret;
+}
+
+//把绝对值写成radix进制，返回写入的末尾，空间不足时返回nullptr
+char* BigInt::write(char* first, char* last, int radix) const {
+	//直接写进调用者的缓冲区，高位补0，再把有效数字移到开头
+	size_t len = std::min(static_cast<size_t>(last - first), limbs::digitsForLimbs(_size, radix));
+	//一定放不下时不必转换
+	if (len < limbs::minDigits(_limbs, _size, radix)) return nullptr;
+	if (!limbs::toChars(first, len, _limbs, _size, radix)) return nullptr;
+	size_t skip{ 0 };
+	while (skip + 1 < len && first[skip] == '0') ++skip;
+	std::memmove(first, first + skip, len - skip);
+	return first + len - skip;
+}
+
+BigInt BigInt::addMagnitude(const BigInt& l, const BigInt& r, bool sign) {
+	const BigInt& longer = l._size >= r._size ? l : r;
+	const BigInt& shorter = l._size >= r._size ? r : l;
+	BigInt ret(resultResource(l, r));
+	ret.reserve(longer._size + 1);
+	limb_t carry = limbs::add(ret._limbs, longer._limbs, longer._size, shorter._limbs, shorter._size);
+	ret._size = longer._size;
+	if (carry) ret._limbs[ret._size++] = carry;
+	ret._sign = sign;
+	ret.normalize();
+	return ret;
+}
+
+BigInt BigInt::subMagnitude(const BigInt& l, const BigInt& r, bool sign) {
+	//|l| < |r|时结果取反
+	bool l_greater = limbs::compare(l._limbs, l._size, r._limbs, r._size) >= 0;
+	const BigInt& greater = l_greater ? l : r;
+	const BigInt& less = l_greater ? r : l;
+	BigInt ret(resultResource(l, r));
+	ret.reserve(greater._size);
+	limbs::sub(ret._limbs, greater._limbs, greater._size, less._limbs, less._size);
+	ret._size = greater._size;
+	ret._sign = l_greater ? sign : !sign;
+	ret.normalize();
+	return ret;
+}
+
+BigInt BigInt::multiBySingle(const BigInt& l, const limb_t& single, std::pmr::memory_resource* resource) {
+	BigInt ret(resource);
+	ret.reserve(l._size + 1);
+	limb_t carry = limbs::mulBySingle(ret._limbs, l._limbs, l._size, single);
+	ret._size = l._size;
+	if (carry) ret._limbs[ret._size++] = carry;
 	ret._sign = l._sign;
+	ret.normalize();
 	return ret;
 }
 
@@ -175,472 +291,613 @@ bool BigInt::sign() const {
 //operators
 API BigInt BigInt::operator-() const {
 	if (!isNaN()) {
-		BigInt rev(*this);
+		BigInt rev(*this, _resource);
 		rev._sign = !_sign;
+		rev.normalize();
 		return rev;
 	}
-	return BigInt();
+	return BigInt(_resource);
 }
 
 API BigInt& BigInt::operator-() {
 	_sign = !_sign;
+	if (!isNaN()) normalize();
 	return *this;
 }
 
 API BigInt& BigInt::operator++() {
-	*this = operator+(*this, 1);
-	return *this;
+	return *this += 1;
 }
 
 API BigInt BigInt::operator++(int) {
-	BigInt temp(*this);
-	*this = operator+(*this, 1);
+	BigInt temp(*this, _resource);
+	*this += 1;
 	return temp;
 }
 
 API BigInt& BigInt::operator--() {
-	*this = ::operator-(*this, 1);
-	return *this;
+	return *this -= 1;
 }
 
 API BigInt BigInt::operator--(int) {
-	BigInt temp(*this);
-	*this = ::operator-(*this, 1);
+	BigInt temp(*this, _resource);
+	*this -= 1;
 	return temp;
 }
 
+void BigInt::addInPlace(const BigInt& r, bool subtract) {
+	if (isNaN() || r.isNaN()) {
+		free();
+		return;
+	}
+	//r可能就是*this，扩容之后再读r的limb
+	bool r_sign{ r._sign != subtract };
+	uint32_t r_size{ r._size };
+	if (_sign == r_sign) {
+		reserve(std::max(_size, r_size) + 1);
+		limb_t carry = _size >= r_size ? limbs::add(_limbs, _limbs, _size, r._limbs, r_size)
+			: limbs::add(_limbs, r._limbs, r_size, _limbs, _size);
+		_size = std::max(_size, r_size);
+		if (carry) _limbs[_size++] = carry;
+	}
+	else if (limbs::compare(_limbs, _size, r._limbs, r_size) >= 0) {
+		limbs::sub(_limbs, _limbs, _size, r._limbs, r_size);
+	}
+	else {
+		reserve(r_size);
+		limbs::sub(_limbs, r._limbs, r_size, _limbs, _size);
+		_size = r_size;
+		_sign = r_sign;
+	}
+	normalize();
+}
+
+API BigInt& BigInt::operator+=(const BigInt& r) {
+	addInPlace(r, false);
+	return *this;
+}
+
+API BigInt& BigInt::operator-=(const BigInt& r) {
+	addInPlace(r, true);
+	return *this;
+}
+
+API BigInt& BigInt::operator*=(const BigInt& r) {
+	if (!isNaN() && !r.isNaN() && r._size <= 1) {
+		//单limb的乘数原地相乘
+		limb_t single{ r._size == 0 ? 0 : *(r._limbs) };
+		bool sign{ _sign == r._sign };
+		reserve(_size + 1);
+		limb_t carry = limbs::mulBySingle(_limbs, _limbs, _size, single);
+		if (carry) _limbs[_size++] = carry;
+		_sign = sign;
+		normalize();
+		return *this;
+	}
+	*this = *this * r;
+	return *this;
+}
+
+API BigInt& BigInt::operator/=(const BigInt& r) {
+	divide(*this, r, this, nullptr);
+	return *this;
+}
+
+API BigInt& BigInt::operator%=(const BigInt& r) {
+	divide(*this, r, nullptr, this);
+	return *this;
+}
+
 API BigInt operator+(const BigInt& l, const BigInt& r) {
 	if (!l.isNaN() && !r.isNaN()) {
-		if (l.sign() && r.sign()) {
-			// all positive
-			int l_len = l._end - l._digits;
-			int r_len = r._end - r._digits;
-			char* res = new char[std::max(l_len, r_len) + 2];
-			char* res_p{ res + std::max(l_len, r_len) + 1 };
-			*(res_p--) = '\0';
-			int carry{ 0 };
-			--l_len, --r_len;
-			while (l_len >= 0 || r_len >= 0) {
-				int l_basic{ l_len < 0 ? 0 : l._digits[l_len] - '0' };
-				int r_basic{ r_len < 0 ? 0 : r._digits[r_len] - '0' };
-				*res_p = (l_basic + r_basic + carry) % 10 + '0';
-				carry = (l_basic + r_basic + carry) / 10;
-
-				--l_len, --r_len, --res_p;
-			}
-			if (carry) {
-				*res_p = carry + '0';
-			}
-			else ++res_p;
-			BigInt ret(res_p);
-			res_p = nullptr;
-			delete[] res;
-			return ret;
-		}
-		else if (!l.sign() && !r.sign()) {
-			// all negtive
-			return -((-l) + (-r));
-		}
-		else {
-			// not same sign
-			bool sign{ operator>=(l,0) };
-			BigInt nature{ sign ? l : r };
-			BigInt negtive{ sign ? r : l };
-			return nature - (-negtive);
+		if (l._sign == r._sign) {
+			return BigInt::addMagnitude(l, r, l._sign);
 		}
+		// not same sign
+		return BigInt::subMagnitude(l, r, l._sign);
 	}
 	return BigInt();
 }
-//TODO:
+
+//右值版本直接复用即将销毁的操作数的缓冲区
+API BigInt operator+(BigInt&& l, const BigInt& r) {
+	l += r;
+	return std::move(l);
+}
+
+API BigInt operator+(const BigInt& l, BigInt&& r) {
+	r += l;
+	return std::move(r);
+}
+
+API BigInt operator+(BigInt&& l, BigInt&& r) {
+	l += r;
+	return std::move(l);
+}
+
 API BigInt operator-(const BigInt& l, const BigInt& r) {
 	if (!l.isNaN() && !r.isNaN()) {
-		BigInt copy{ l };
-		std::string sres(std::max(l.digits10(), r.digits10()), '\0');
-		int index = sres.size() - 1;
-		bool l_sign{ l.sign() }, r_sign{ r.sign() };
-		if (l_sign && r_sign) {
-			if (l > r) {
-				int i = l.digits10() - 1, j = r.digits10() - 1;
-				while (i >= 0) {
-					int lbasic = i < 0 ? 0 : (copy._digits[i] - '0');
-					int rbasic = j < 0 ? 0 : (r._digits[j] - '0');
-					int res{ lbasic - rbasic };
-					if (res < 0) {
-						int k{ i - 1 };
-						while (k >= 0 && copy._digits[k] == '0') {
-							copy._digits[k] = '9';
-							--k;
-						}
-						--copy._digits[k];
-						res += 10;
-					}
-					sres[index--] = res + '0';
-					--i, --j;
-				}
-				auto n0iter{ sres.begin() };
-				while (n0iter + 1 != sres.end() && *n0iter == '0') ++n0iter;
-				int head = n0iter - sres.begin();
-				return BigInt(std::string_view(sres.data() + head, sres.size() - head));
-			}
-			else return -(r - l);
-		}
-		else if (l_sign && !r_sign) {
-			return l + (-r);
-		}
-		else if (!l_sign && r_sign) {
-			return -((-l) + r);
+		if (l._sign != r._sign) {
+			return BigInt::addMagnitude(l, r, l._sign);
 		}
-		return (-r) - (-l);
+		return BigInt::subMagnitude(l, r, l._sign);
 	}
 	return BigInt();
 }
 
-API bool operator>(const BigInt& l, const BigInt& r) {
-	if (!l.isNaN() && !r.isNaN()) {
-		bool l_neg{ !l.sign() };
-		bool r_neg{ !r.sign() };
-		if (l_neg && r_neg) {
-			if (l.digits10() != r.digits10()) {
-				return l.digits10() < r.digits10();
-			}
-			l_neg = false;
-			for (int i = 1; l._digits + i != l._end; ++i) {
-				if (l._digits[i] > r._digits[i]) {
-					return false;
-				}
-				else if (l._digits[i] < r._digits[i]) {
-					l_neg = true;
-					break;
-				}
-			}
-		}
-		else if (!l_neg && !r_neg) {
-			if (l.digits10() != r.digits10()) {
-				return l.digits10() > r.digits10();
-			}
-			l_neg = false;
-			for (int i = 0; l._digits + i != l._end; ++i) {
-				if (l._digits[i] < r._digits[i]) {
-					return false;
-				}
-				else if (l._digits[i] > r._digits[i]) {
-					l_neg = true;
-					break;
-				}
-			}
-		}
-		else {
-			l_neg = !l_neg;
-		}
-		return l_neg;
+API BigInt operator-(BigInt&& l, const BigInt& r) {
+	l -= r;
+	return std::move(l);
+}
+
+API BigInt operator-(const BigInt& l, BigInt&& r) {
+	r -= l;
+	-r;
+	return std::move(r);
+}
+
+API BigInt operator-(BigInt&& l, BigInt&& r) {
+	l -= r;
+	return std::move(l);
+}
+
+API int BigInt::compare(const BigInt& r) const {
+	if (isNaN() || r.isNaN()) {
+		return int(!isNaN()) - int(!r.isNaN());
 	}
-	return false;
+	if (_sign != r._sign) {
+		return _sign ? 1 : -1;
+	}
+	int cmp = limbs::compare(_limbs, _size, r._limbs, r._size);
+	return _sign ? cmp : -cmp;
 }
 
-API bool operator==(const BigInt& l, const BigInt& r) {
-	if (!l.isNaN() && !r.isNaN()) {
-		int l_len = l._end - l._digits;
-		int r_len = r._end - r._digits;
-		int min_len = std::min(l_len, r_len);
-		bool condition{ true };
-		for (int i = 0; i < min_len; ++i) {
-			if (l._digits[i] != r._digits[i]) {
-				condition = false;
-				break;
-			}
-		}
-		return condition && l_len == r_len;
+int BigInt::compareInteger(unsigned long long magnitude, bool sign) const {
+	if (isNaN()) return -1;
+	if (_sign != sign) {
+		return _sign ? 1 : -1;
 	}
-	return false;
+	limb_t r_limbs[2] = { static_cast<limb_t>(magnitude), static_cast<limb_t>(magnitude >> limbs::limb_bits) };
+	uint32_t r_size = limbs::normalizedSize(r_limbs, 2);
+	int cmp = limbs::compare(_limbs, _size, r_limbs, r_size);
+	return _sign ? cmp : -cmp;
+}
+
+API bool operator>(const BigInt& l, const BigInt& r) {
+	return !l.isNaN() && !r.isNaN() && l.compare(r) > 0;
+}
+
+API bool operator==(const BigInt& l, const BigInt& r) {
+	return !l.isNaN() && !r.isNaN() && l.compare(r) == 0;
+}
+
+API bool operator!=(const BigInt& l, const BigInt& r) {
+	return !(l == r);
 }
 
 API bool operator>=(const BigInt& l, const BigInt& r) {
-	return l == r || l > r;
+	return !l.isNaN() && !r.isNaN() && l.compare(r) >= 0;
 }
 
 API bool operator<(const BigInt& l, const BigInt& r) {
-	return !(l > r || l == r);
+	return !l.isNaN() && !r.isNaN() && l.compare(r) < 0;
 }
 
 API bool operator<=(const BigInt& l, const BigInt& r) {
-	return !(l > r);
+	return !l.isNaN() && !r.isNaN() && l.compare(r) <= 0;
+}
+
+#ifdef BIGINT_HAS_SPACESHIP
+API std::partial_ordering operator<=>(const BigInt& l, const BigInt& r) {
+	if (l.isNaN() || r.isNaN()) return std::partial_ordering::unordered;
+	int cmp = l.compare(r);
+	return cmp < 0 ? std::partial_ordering::less : (cmp > 0 ? std::partial_ordering::greater : std::partial_ordering::equivalent);
 }
-//fft o(nlogn)
+#endif
 API BigInt operator*(const BigInt& l, const BigInt& r) {
 	if (!l.isNaN() && !r.isNaN()) {
-		BigInt ret;
-		uint32_t lsz{ l.digits10() }, rsz{ r.digits10() };
-		if (lsz == 1) {
-			ret = BigInt::multiBySingle(r, (*(l._digits)));
+		std::pmr::memory_resource* resource = BigInt::resultResource(l, r);
+		BigInt ret(resource);
+		if (l._size <= 1) {
+			ret = BigInt::multiBySingle(r, l._size == 0 ? 0 : *(l._limbs), resource);
 			ret._sign = l._sign == r._sign;
+			ret.normalize();
 			return ret;
 		}
-		else if (rsz == 1) {
-			ret = BigInt::multiBySingle(l, (*(r._digits)));
+		else if (r._size <= 1) {
+			ret = BigInt::multiBySingle(l, r._size == 0 ? 0 : *(r._limbs), resource);
 			ret._sign = l._sign == r._sign;
+			ret.normalize();
 			return ret;
 		}
-		uint32_t pow2sz{ 1u << std::max((uint32_t)std::ceil(std::log2(lsz + rsz)),1u) };
-
-		std::vector<std::complex<double>> lply(pow2sz, std::complex<double>());
-		std::vector<std::complex<double>> rply(pow2sz, std::complex<double>());
-
-		for (uint32_t i = 0; i < lsz; ++i) {
-			lply[i].real(*(l._end - 1 - i) - '0');
-		}
-		for (uint32_t i = 0; i < rsz; ++i) {
-			rply[i].real(*(r._end - 1 - i) - '0');
-		}
-		BigInt::fft(lply, false);
-		BigInt::fft(rply, false);
-		for (int i = 0; i < pow2sz; ++i) {
-			lply[i] = lply[i] * rply[i];
-		}
-		BigInt::fft(lply, true);
-		for (int i = 0; i < pow2sz; ++i) {
-			lply[i]._Val[0] = (lply[i]._Val[0] / pow2sz) + 1e-8;
-		}
-		//进位
-		int carry{ 0 };
-		for (uint32_t i = 0; i < pow2sz; ++i) {
-			int basic = (int)lply[i]._Val[0] + carry;
-			lply[i]._Val[0] = basic % 10;
-			carry = basic / 10;
-		}
-		//除去前导0
-		uint32_t start{ pow2sz - 1 };
-		while (start >= 0 && lply[start].real() < 1) {
-			--start;
-		}
+		uint32_t res_sz{ l._size + r._size };
+		ret.reserve(res_sz);
+		limbs::mul(ret._limbs, l._limbs, l._size, r._limbs, r._size);
+		ret._size = res_sz;
 		//符号
-		bool sign{ l.sign() == r.sign() };
-		//构造结果
-		std::string multi_res(start + 1, '\0');
-		for (uint32_t i = 0; i < start + 1; ++i) {
-			multi_res[i] = lply[start - i].real() + '0';
-		}
-		ret = multi_res;
-		if (!sign) - ret;
+		ret._sign = l.sign() == r.sign();
+		ret.normalize();
 		return ret;
 	}
 	return BigInt();
 }
 
+void BigInt::divide(const BigInt& l, const BigInt& r, BigInt* quotient, BigInt* remainder) {
+	//截断除法: 商向0取整，余数与被除数同号
+	if (l.isNaN() || r.isNaN()) {
+		if (quotient) *quotient = BigInt();
+		if (remainder) *remainder = BigInt();
+		return;
+	}
+	if (r._size == 0) throw std::domain_error("divided by zero!");
+	if (limbs::compare(l._limbs, l._size, r._limbs, r._size) < 0) {
+		if (remainder) *remainder = l;
+		if (quotient) *quotient = BigInt(0);
+		return;
+	}
+	BigInt quo(resultResource(l, r)), rem(resultResource(l, r));
+	quo.reserve(l._size - r._size + 1);
+	rem.reserve(r._size);
+	limbs::divmod(quo._limbs, rem._limbs, l._limbs, l._size, r._limbs, r._size);
+	quo._size = l._size - r._size + 1;
+	quo._sign = l._sign == r._sign;
+	quo.normalize();
+	rem._size = r._size;
+	rem._sign = l._sign;
+	rem.normalize();
+	if (quotient) *quotient = std::move(quo);
+	if (remainder) *remainder = std::move(rem);
+}
+
 API BigInt operator/(const BigInt& l, const BigInt& r)
 {
 	//大除法
-	if (!l.isNaN() && !r.isNaN()) {
-		if (r == 0) throw std::exception("divided by zero!");
-		BigInt _r = r < 0 ? -r : r;
+	BigInt quotient(BigInt::resultResource(l, r));
+	BigInt::divide(l, r, &quotient, nullptr);
+	return quotient;
+}
 
-		auto dig_r{ r.digits10() };
-		auto dig_l{ l.digits10() };
-		std::string quotient;
-		std::string remainder;
-		bool l_sign = l.sign(), r_sign = r.sign();
+API BigInt operator%(const BigInt& l, const BigInt& r) {
+	BigInt remainder(BigInt::resultResource(l, r));
+	BigInt::divide(l, r, nullptr, &remainder);
+	return remainder;
+}
 
-		uint32_t i{ 0 };
-		for (; i < dig_r - 1; ++i) {
-			if (i >= dig_l) return BigInt(0);
-			remainder.push_back(l._digits[i]);
+void BigInt::shiftLeft(BigInt& out, const BigInt& l, uint64_t shift) {
+	if (l.isNaN()) {
+		out.free();
+		return;
+	}
+	if (l._size == 0) {
+		out.assign(0, true);
+		return;
+	}
+	uint64_t words = shift / limbs::limb_bits;
+	if (words + l._size + 1 > std::numeric_limits<uint32_t>::max()) throw std::overflow_error("BigInt too large");
+	uint32_t w{ static_cast<uint32_t>(words) }, size{ l._size };
+	bool sign{ l._sign };
+	//out就是l时扩容后再读它的limb，从高位往低位写不会覆盖还没读的部分
+	out.reserve(size + w + 1);
+	const limb_t* src = l._limbs;
+	int bits = static_cast<int>(shift % limbs::limb_bits);
+	if (bits == 0) {
+		memmove((void*)(out._limbs + w), (const void*)src, size * sizeof(limb_t));
+		out._limbs[size + w] = 0;
+	}
+	else {
+		out._limbs[size + w] = limbs::lshift(out._limbs + w, src, size, bits);
+	}
+	memset((void*)out._limbs, 0, w * sizeof(limb_t));
+	out._size = size + w + 1;
+	out._sign = sign;
+	out.normalize();
+}
+
+void BigInt::shiftRight(BigInt& out, const BigInt& l, uint64_t shift) {
+	if (l.isNaN()) {
+		out.free();
+		return;
+	}
+	uint64_t words = shift / limbs::limb_bits;
+	int bits = static_cast<int>(shift % limbs::limb_bits);
+	bool sign{ l._sign };
+	if (words >= l._size) {
+		//负数全部移出后是-1
+		out.assign(!sign, sign);
+		return;
+	}
+	uint32_t w{ static_cast<uint32_t>(words) }, size{ l._size - w };
+	//负数向负无穷取整，移出的位中有1时绝对值加1
+	bool lost{ false };
+	if (!sign) {
+		lost = limbs::normalizedSize(l._limbs, w) != 0 || (bits != 0 && (l._limbs[w] << (limbs::limb_bits - bits)) != 0);
+	}
+	out.reserve(size + 1);
+	//从低位往高位写，out就是l时也不会覆盖还没读的部分
+	limbs::rshift(out._limbs, l._limbs + w, size, bits);
+	out._size = size;
+	out._sign = sign;
+	if (lost) {
+		limb_t one{ 1 };
+		limb_t carry = limbs::add(out._limbs, out._limbs, size, &one, 1);
+		if (carry) out._limbs[out._size++] = carry;
+	}
+	out.normalize();
+}
+
+//负数的补码是~(|x| - 1)，逐limb转换、运算，结果为负时再用~v + 1取回绝对值，只遍历一次
+template<typename Op>
+void BigInt::bitwise(BigInt& out, const BigInt& l, const BigInt& r, Op op) {
+	if (l.isNaN() || r.isNaN()) {
+		out.free();
+		return;
+	}
+	bool l_neg{ !l._sign }, r_neg{ !r._sign };
+	//高位的符号位运算后就是结果的符号
+	bool neg = op(limb_t(0) - l_neg, limb_t(0) - r_neg) != 0;
+	uint32_t ls{ l._size }, rs{ r._size }, n{ std::max(l._size, r._size) };
+	out.reserve(n + 1);
+	const limb_t* a = l._limbs;
+	const limb_t* b = r._limbs;
+	limb_t l_borrow{ l_neg }, r_borrow{ r_neg }, carry{ neg };
+	for (uint32_t i = 0; i < n; ++i) {
+		limb_t x{ i < ls ? a[i] : 0 }, y{ i < rs ? b[i] : 0 };
+		if (l_neg) {
+			limb_t t = x - l_borrow;
+			l_borrow &= x == 0;
+			x = ~t;
 		}
-		while (i < dig_l) {
-			remainder.push_back(l._digits[i]);
-			//binary search
-			int left{ 0 }, right{ 9 };
-			while (left < right) {
-				int middle{ right - (right - left) / 2 };
-				auto multi_res = BigInt::multiBySingle(_r, middle + '0');
-				if (multi_res > remainder) {
-					right = middle - 1;
-				}
-				else {
-					left = middle;
-				}
-			}
-			quotient.push_back(left + '0');
-
-			auto int_remain = BigInt(remainder) - BigInt::multiBySingle(_r, left + '0');
-			remainder = util::to_string(int_remain);
-			++i;
+		if (r_neg) {
+			limb_t t = y - r_borrow;
+			r_borrow &= y == 0;
+			y = ~t;
 		}
-		BigInt ret(0);
-		if (!quotient.empty()) {
-			int head = quotient.size() == 1 ? 0 : quotient.front() == '0';
-			std::string_view quo_v(quotient.data() + head, quotient.size() - head);
-			ret = BigInt(quo_v);
-			if (!(l_sign ^ r_sign)) {
-				ret._sign = true;
-			}
-			else {
-				ret._sign = false;
-			}
+		limb_t v = op(x, y);
+		if (neg) {
+			v = ~v + carry;
+			carry &= v == 0;
 		}
-		return ret;
+		out._limbs[i] = v;
 	}
-	return BigInt();
+	out._limbs[n] = carry;
+	out._size = n + 1;
+	out._sign = !neg;
+	out.normalize();
 }
 
-API BigInt operator%(const BigInt& l, const BigInt& r) {
-	if (!l.isNaN() && !r.isNaN()) {
-		BigInt quotient = l / r;
-		BigInt remainder = l - r * quotient;
-		return remainder;
-	}
-	return BigInt();
+API BigInt BigInt::operator~() const {
+	if (isNaN()) return BigInt(_resource);
+	//~x = -(x + 1)
+	BigInt ret(*this, _resource);
+	ret += 1;
+	ret._sign = !ret._sign;
+	ret.normalize();
+	return ret;
+}
+
+API BigInt& BigInt::operator<<=(uint64_t shift) {
+	shiftLeft(*this, *this, shift);
+	return *this;
+}
+
+API BigInt& BigInt::operator>>=(uint64_t shift) {
+	shiftRight(*this, *this, shift);
+	return *this;
+}
+
+API BigInt& BigInt::operator&=(const BigInt& r) {
+	bitwise(*this, *this, r, [](limb_t x, limb_t y) { return x & y; });
+	return *this;
+}
+
+API BigInt& BigInt::operator|=(const BigInt& r) {
+	bitwise(*this, *this, r, [](limb_t x, limb_t y) { return x | y; });
+	return *this;
+}
+
+API BigInt& BigInt::operator^=(const BigInt& r) {
+	bitwise(*this, *this, r, [](limb_t x, limb_t y) { return x ^ y; });
+	return *this;
+}
+
+API BigInt operator<<(const BigInt& l, uint64_t shift) {
+	BigInt ret(l._resource);
+	BigInt::shiftLeft(ret, l, shift);
+	return ret;
+}
+
+API BigInt operator>>(const BigInt& l, uint64_t shift) {
+	BigInt ret(l._resource);
+	BigInt::shiftRight(ret, l, shift);
+	return ret;
+}
+
+API BigInt operator&(const BigInt& l, const BigInt& r) {
+	BigInt ret(BigInt::resultResource(l, r));
+	BigInt::bitwise(ret, l, r, [](BigInt::limb_t x, BigInt::limb_t y) { return x & y; });
+	return ret;
+}
+
+API BigInt operator|(const BigInt& l, const BigInt& r) {
+	BigInt ret(BigInt::resultResource(l, r));
+	BigInt::bitwise(ret, l, r, [](BigInt::limb_t x, BigInt::limb_t y) { return x | y; });
+	return ret;
+}
+
+API BigInt operator^(const BigInt& l, const BigInt& r) {
+	BigInt ret(BigInt::resultResource(l, r));
+	BigInt::bitwise(ret, l, r, [](BigInt::limb_t x, BigInt::limb_t y) { return x ^ y; });
+	return ret;
 }
 
 API BigInt& BigInt::operator=(const BigInt& in) {
-	free();
+	if (this == &in) return *this;
+	if (in.isNaN()) {
+		free();
+		return *this;
+	}
+	reserve(in._size);
+	memcpy((void*)_limbs, (const void*)in._limbs, in._size * sizeof(limb_t));
+	_size = in._size;
 	_sign = in._sign;
-	size_t sz = in.digits10();
-	_digits = new char[sz];
-	_end = _digits + sz;
-	memcpy((void*)_digits, (const void*)in._digits, sz);
 	return *this;
 }
 
 API BigInt& BigInt::operator=(BigInt&& move) {
+	if (this == &move) return *this;
+	//资源不同时不能接管对方的缓冲区，按拷贝处理
+	if (_resource != move._resource) return *this = static_cast<const BigInt&>(move);
+	if (move.isInline() && !isNaN()) {
+		//已有的缓冲区足够放下内联的值，不必释放
+		memcpy((void*)_limbs, (const void*)move._limbs, move._size * sizeof(limb_t));
+		_size = move._size;
+		_sign = move._sign;
+		return *this;
+	}
 	free();
-
-	_digits = move._digits;
-	_end = move._end;
-	_sign = move._sign;
-
-	move._digits = nullptr;
-	move._end = nullptr;
-	move._sign = true;
+	steal(move);
 
 	return *this;
 }
 
-API std::ostream& operator<<(std::ostream& o, BigInt& bInt) {
-	o << util::to_string(bInt);
+API std::ostream& operator<<(std::ostream& o, const BigInt& bInt) {
+	//较小的值直接在栈上格式化
+	char stack_buf[128];
+	std::unique_ptr<char[]> heap_buf;
+	size_t len = limbs::digitsForLimbs(bInt._size, 10) + 1;
+	char* buf = stack_buf;
+	if (len > sizeof(stack_buf)) {
+		heap_buf.reset(new char[len]);
+		buf = heap_buf.get();
+	}
+	auto [end, ec] = util::to_chars(buf, buf + len, bInt);
+	o << std::string_view(buf, ec == std::errc() ? end - buf : 0);
 	return o;
 }
-//TODO:处理浮点缩窄，输入错误的情况
+//跳过空白后读入可选的'-'和尽可能多的数字，遇到其它字符停下且不取走
+//没有数字时设置failbit并把bInt置为NaN
 API std::istream& operator>>(std::istream& i, BigInt& bInt) {
-	std::string data;
-	i >> data;
-	size_t size = data.size();
-	bInt.free();
-	bInt._digits = new char[size];
-	bInt._end = bInt._digits + size;
-	bInt._sign = true;
-	memcpy(bInt._digits, data.data(), size);
-	if (*bInt._digits == '-') {
-		++bInt._digits;
-		bInt._sign = false;
-	}
+	std::istream::sentry guard(i);
+	if (!guard) return i;
+	using traits = std::istream::traits_type;
+	std::streambuf* buf = i.rdbuf();
+	//每凑满一块数字就转换并合并到已有的limb上，不保存整个数字串
+	limbs::DigitAccumulator acc(10);
+	std::ios_base::iostate state = std::ios_base::goodbit;
+	traits::int_type c = buf->sgetc();
+	bool negative = c == traits::to_int_type('-');
+	if (negative) c = buf->snextc();
+	for (; !traits::eq_int_type(c, traits::eof()); c = buf->snextc()) {
+		char ch = traits::to_char_type(c);
+		if (ch < '0' || ch > '9') break;
+		acc.push(ch);
+	}
+	if (traits::eq_int_type(c, traits::eof())) state |= std::ios_base::eofbit;
+	if (acc.digits() == 0) {
+		bInt.free();
+		state |= std::ios_base::failbit;
+	}
+	else {
+		bInt.reserve(acc.size());
+		bInt._size = acc.finish(bInt._limbs);
+		bInt._sign = !negative;
+		bInt.normalize();
+	}
+	i.setstate(state);
 	return i;
 }
 
-API BigInt::operator long long() const {
-	long long ll;
-	try {
-		ll = std::stoll(util::to_string(*this));
-	}
-	catch (std::out_of_range&) {
-		if (_sign) return LLONG_MAX;
-		else return LLONG_MIN;
+bool BigInt::magnitude64(unsigned long long& magnitude) const {
+	if (_size > 2) return false;
+	magnitude = 0;
+	for (uint32_t i = _size; i-- > 0;) {
+		magnitude = (magnitude << limbs::limb_bits) | _limbs[i];
 	}
-	return ll;
+	return true;
+}
+
+API BigInt::operator long long() const {
+	long long ret;
+	convert(ret);
+	return ret;
 }
 
 API BigInt::operator long() const {
-	long l;
-	try {
-		l = std::stol(util::to_string(*this));
-	}
-	catch (std::out_of_range&) {
-		if (_sign) return LONG_MAX;
-		else return LONG_MIN;
-	}
-	return l;
+	long ret;
+	convert(ret);
+	return ret;
 }
 
 API BigInt::operator int() const {
-	int i;
-	try {
-		i = std::stoi(util::to_string(*this));
-	}
-	catch (std::out_of_range& out) {
-		if (_sign) return INT_MAX;
-		else return INT_MIN;
-	}
-	return i;
+	int ret;
+	convert(ret);
+	return ret;
 }
 
 API BigInt::operator short() const {
-	if (*this > BigInt(SHRT_MAX)) {
-		return SHRT_MAX;
-	}
-	else if (*this < BigInt(SHRT_MIN)) {
-		return SHRT_MIN;
-	}
-	return short(int(*this));
+	short ret;
+	convert(ret);
+	return ret;
 }
 
 API BigInt::operator char() const {
-	if (*this > BigInt(CHAR_MAX)) {
-		return CHAR_MAX;
-	}
-	else if (*this < BigInt(CHAR_MIN)) {
-		return CHAR_MIN;
-	}
-	return char(int(*this));
+	char ret;
+	convert(ret);
+	return ret;
 }
 
 API BigInt::operator unsigned long long() const {
-	if (!_sign) return 0;
-	unsigned long long ull;
-	try {
-		ull = std::stoull(util::to_string(*this));
-	}
-	catch (std::out_of_range& out) {
-		return ULLONG_MAX;
-	}
-	return ull;
+	unsigned long long ret;
+	convert(ret);
+	return ret;
 }
 
 API BigInt::operator unsigned long() const {
-	if (!_sign) return 0;
-	unsigned long ul;
-	try {
-		ul = std::stoul(util::to_string(*this));
-	}
-	catch (std::out_of_range&) {
-		return ULONG_MAX;
-	}
-	return ul;
+	unsigned long ret;
+	convert(ret);
+	return ret;
 }
 
 API BigInt::operator unsigned int() const {
-	if (!_sign) return 0;
-	if (*this > BigInt(UINT32_MAX)) {
-		return UINT32_MAX;
-	}
-	return unsigned int(unsigned long(*this));
+	unsigned int ret;
+	convert(ret);
+	return ret;
 }
 
 API BigInt::operator unsigned short() const {
-	if (!_sign) return 0;
-	if (*this > BigInt(USHRT_MAX)) {
-		return USHRT_MAX;
-	}
-	return unsigned short(unsigned long(*this));
+	unsigned short ret;
+	convert(ret);
+	return ret;
 }
 
 API BigInt::operator unsigned char() const {
-	if (!_sign) return 0;
-	if (*this > BigInt(UCHAR_MAX)) {
-		return UCHAR_MAX;
-	}
-	return unsigned char(unsigned long(*this));
+	unsigned char ret;
+	convert(ret);
+	return ret;
 }
 
 namespace std {
-	std::size_t hash<BigInt>::operator()(const BigInt& bInt) const {
-		return hash<std::string>{}(util::to_string(bInt));
+	//每次吸收两个limb凑成的64位字，乘法和移位混合，最后用murmur3的fmix64收尾
+	std::size_t hash<BigInt>::operator()(const BigInt& bInt) const noexcept {
+		constexpr uint64_t k = 0x9e3779b97f4a7c15ull;
+		if (bInt.isNaN()) return static_cast<std::size_t>(k);
+		const BigInt::limb_t* l = bInt._limbs;
+		uint32_t n = bInt._size;
+		uint64_t h = ((uint64_t(n) << 1) | bInt._sign) * k;
+		uint32_t i{ 0 };
+		for (; i + 1 < n; i += 2) {
+			h = (h ^ ((uint64_t(l[i + 1]) << 32) | l[i])) * k;
+			h ^= h >> 29;
+		}
+		if (i < n) {
+			h = (h ^ l[i]) * k;
+			h ^= h >> 29;
+		}
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdull;
+		h ^= h >> 33;
+		h *= 0xc4ceb9fe1a85ec53ull;
+		h ^= h >> 33;
+		return static_cast<std::size_t>(h);
 	}
 }
@@ -5,13 +5,36 @@
 #include<vector>
 #include<complex>
 #include<string>
+#include<cstdint>
+#include<limits>
+#include<type_traits>
+#include<memory_resource>
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+#define BIGINT_HAS_SPACESHIP
+#include<compare>
+#endif
 class util;
+class BigIntView;
+class BigIntWriter;
+class batch;
+class Modulus;
 class __declspec(dllexport) BigInt {
 	friend class util;
+	friend class BigIntView;
+	friend class BigIntWriter;
+	friend class batch;
+	friend class Modulus;
 public:
-	API BigInt() :_digits{ nullptr }, _end{ nullptr }{}
+	using limb_t = uint32_t;
+
+	API BigInt() :_limbs{ nullptr }, _size{ 0 }, _cap{ 0 }{}
 	API BigInt(const BigInt& in);
 	API BigInt(BigInt&& in);
+	//limb从resource分配，nullptr表示全局的new/delete
+	//运算结果使用左操作数的资源，左操作数使用全局new/delete时使用右操作数的资源
+	//拷贝构造使用std::pmr::get_default_resource()，移动构造保留原来的资源
+	API explicit BigInt(std::pmr::memory_resource* resource);
+	API BigInt(const BigInt& in, std::pmr::memory_resource* resource);
 	API BigInt(std::string& str_in) : BigInt(static_cast<const std::string&>(str_in)) {}
 	API BigInt(const std::string& str_in);
 	API BigInt(std::string_view& str_v) : BigInt(static_cast<const std::string_view&>(str_v)) {}
@@ -26,6 +49,13 @@ public:
 	~BigInt();
 
 	API bool isNaN() const;
+	API std::pmr::memory_resource* resource() const;
+
+	//三路比较，一次遍历得到 -1, 0, 1
+	//NaN排在所有数之前，两个NaN相等，因此compare是全序，可以直接用于排序
+	API int compare(const BigInt& r) const;
+	template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+	int compare(const Int& r) const;
 
 	API BigInt& operator=(const BigInt& in);
 	API BigInt& operator=(BigInt&& move);
@@ -37,19 +67,47 @@ public:
 	API BigInt& operator--();
 	API BigInt operator--(int);
 
+	API BigInt& operator+=(const BigInt& r);
+	API BigInt& operator-=(const BigInt& r);
+	API BigInt& operator*=(const BigInt& r);
+	API BigInt& operator/=(const BigInt& r);
+	API BigInt& operator%=(const BigInt& r);
+	//位运算按二进制补码，负数的高位都是1；>>向负无穷取整
+	API BigInt operator~() const;
+	API BigInt& operator<<=(uint64_t shift);
+	API BigInt& operator>>=(uint64_t shift);
+	API BigInt& operator&=(const BigInt& r);
+	API BigInt& operator|=(const BigInt& r);
+	API BigInt& operator^=(const BigInt& r);
+
 	API friend BigInt operator+(const BigInt& l, const BigInt& r);
+	API friend BigInt operator+(BigInt&& l, const BigInt& r);
+	API friend BigInt operator+(const BigInt& l, BigInt&& r);
+	API friend BigInt operator+(BigInt&& l, BigInt&& r);
 	API friend BigInt operator-(const BigInt& l, const BigInt& r);
+	API friend BigInt operator-(BigInt&& l, const BigInt& r);
+	API friend BigInt operator-(const BigInt& l, BigInt&& r);
+	API friend BigInt operator-(BigInt&& l, BigInt&& r);
 	API friend BigInt operator*(const BigInt& l, const BigInt& r);
 	API friend BigInt operator/(const BigInt& l, const BigInt& r);
 	API friend BigInt operator%(const BigInt& l, const BigInt& r);
+	API friend BigInt operator<<(const BigInt& l, uint64_t shift);
+	API friend BigInt operator>>(const BigInt& l, uint64_t shift);
+	API friend BigInt operator&(const BigInt& l, const BigInt& r);
+	API friend BigInt operator|(const BigInt& l, const BigInt& r);
+	API friend BigInt operator^(const BigInt& l, const BigInt& r);
 
 	API friend bool operator>(const BigInt& l, const BigInt& r);
 	API friend bool operator==(const BigInt& l, const BigInt& r);
+	API friend bool operator!=(const BigInt& l, const BigInt& r);
 	API friend bool operator>=(const BigInt& l, const BigInt& r);
 	API friend bool operator<(const BigInt& l, const BigInt& r);
 	API friend bool operator<=(const BigInt& l, const BigInt& r);
+#ifdef BIGINT_HAS_SPACESHIP
+	API friend std::partial_ordering operator<=>(const BigInt& l, const BigInt& r);
+#endif
 
-	API friend std::ostream& operator<<(std::ostream& o, BigInt& bInt);
+	API friend std::ostream& operator<<(std::ostream& o, const BigInt& bInt);
 	API friend std::istream& operator>>(std::istream& i, BigInt& bInt);
 
 	API explicit operator long long() const;
@@ -64,118 +122,166 @@ public:
 	API explicit operator unsigned char() const;
 private:
 	uint32_t digits10() const;
-	bool isValidString(const std::string_view& str) const;
+	const char* parse(const char* first, const char* last, int radix);
 	void swap(BigInt& in);
-	inline bool sign() const;
-	inline void free();
-	static BigInt multiBySingle(const BigInt& l, const char& single);
-	static void fft(std::vector<std::complex<double>>& ply, bool is_inverse);
+	bool sign() const;
+	void free();
+	limb_t* allocate(uint32_t cap);
+	void deallocate(limb_t* limbs, uint32_t cap);
+	static std::pmr::memory_resource* resultResource(const BigInt& l, const BigInt& r);
+	bool isInline() const;
+	void reserve(uint32_t cap);
+	void steal(BigInt& in);
+	void normalize();
+	void assign(unsigned long long magnitude, bool sign);
+	void assign(double in);
+	std::string toString(int radix) const;
+	char* write(char* first, char* last, int radix) const;
+	int compareInteger(unsigned long long magnitude, bool sign) const;
+	bool magnitude64(unsigned long long& magnitude) const;
+	template<typename Int>
+	bool convert(Int& out) const;
+	void addInPlace(const BigInt& r, bool subtract);
+	static BigInt addMagnitude(const BigInt& l, const BigInt& r, bool sign);
+	static BigInt subMagnitude(const BigInt& l, const BigInt& r, bool sign);
+	static BigInt multiBySingle(const BigInt& l, const limb_t& single, std::pmr::memory_resource* resource);
+	static void divide(const BigInt& l, const BigInt& r, BigInt* quotient, BigInt* remainder);
+	//out可以就是l或r
+	static void shiftLeft(BigInt& out, const BigInt& l, uint64_t shift);
+	static void shiftRight(BigInt& out, const BigInt& l, uint64_t shift);
+	template<typename Op>
+	static void bitwise(BigInt& out, const BigInt& l, const BigInt& r, Op op);
+	static uint64_t allocations();
 public:
-	char* _digits{ nullptr };
-	char* _end{ nullptr };
+	//不超过inline_limbs个limb的值直接存放在对象内部
+	//比128位多留一个limb给进位，结果不超过128位的运算按n + 1预留空间时也不会分配；由于对齐，对象并没有变大
+	static constexpr uint32_t inline_limbs = 5;
+
+	//小端序的32位limb，_limbs == nullptr表示NaN，_size == 0表示0
+	limb_t* _limbs{ nullptr };
+	uint32_t _size{ 0 };
+	uint32_t _cap{ 0 };
 	bool _sign{ true };
+	limb_t _inline[inline_limbs];
+	std::pmr::memory_resource* _resource{ nullptr };
 };
 
 template<typename Int, typename std::enable_if_t<std::disjunction_v<std::is_integral<Int>, std::is_convertible<Int, double>, std::is_convertible<double, Int>>,bool>>
 API BigInt::BigInt(const Int& in) {
 	if constexpr (std::is_integral_v<Int>) {
-		Int copy = in;
-		if (copy == std::numeric_limits<Int>::min()) {
-			std::string min = std::to_string(std::numeric_limits<Int>::min());
-			int alloc_sz = min.size();
-			if (min.front() == '-') {
-				--alloc_sz;
-				_sign = false;
-			}
-			_digits = new char[alloc_sz];
-			_end = _digits + alloc_sz;
-			memcpy((void*)_digits, (const void*)(min.data() + !_sign), alloc_sz);
+		if constexpr (std::is_unsigned_v<Int>) {
+			assign(static_cast<unsigned long long>(in), true);
 		}
 		else {
-			copy = std::is_unsigned_v<Int> ? in : (in < 0 ? -in : in);
-			size_t sz{ copy == 0 };
-			while (copy > 0) {
-				copy /= 10;
-				++sz;
-			}
-			_digits = new char[sz];
-			_end = _digits + sz;
-			char* p = _end - 1;
-			copy = std::is_unsigned_v<Int> ? in : (in < 0 ? -in : in);
-			if (copy == 0) *_digits = '0';
-			else {
-				while (copy > 0) {
-					*p = '0' + (copy % 10);
-					copy /= 10;
-					--p;
-				}
-				if (in < 0) _sign = false;
-			}
+			//先转成无符号再取反，避免最小值溢出
+			unsigned long long magnitude = static_cast<unsigned long long>(in);
+			assign(in < 0 ? 0ull - magnitude : magnitude, in >= 0);
 		}
 	}
 	else if constexpr (std::is_convertible_v<Int, double> && std::is_convertible_v<double, Int>) {
-		if ((double)in <= std::numeric_limits<double>::max() && (double)in >= -std::numeric_limits<double>::max() &&
-			in <= Int(std::numeric_limits<double>::max()) && in >= -Int(std::numeric_limits<double>::max())) {
-			double fin{ double(in) };
-			if (fin >= double(std::numeric_limits<unsigned long long>::max()) || fin <= double(std::numeric_limits<long long>::min())) {
-				double din{ std::abs(fin) };
-				size_t sz{ 0 };
-				while (din >= 1) {
-					din /= 10;
-					++sz;
-				}
-				_digits = new char[sz];
-				_end = _digits + sz;
-				char* p = _end - 1;
-				din = (double)std::abs(fin);
-				while (din >= 1) {
-					*p = '0' + (int)std::fmod(din, 10.f);
-					din /= 10;
-					--p;
-				}
-			}
-			else if (fin >= double(std::numeric_limits<long long>::max())) {
-				unsigned long long ullin = (unsigned long long)fin;
-				size_t sz{ 0 };
-				while (ullin > 0) {
-					ullin /= 10;
-					++sz;
-				}
-				_digits = new char[sz];
-				_end = _digits + sz;
-				char* p = _end - 1;
-				ullin = (unsigned long long)std::abs(fin);
-				while (ullin > 0) {
-					*p = '0' + (ullin) % 10;
-					ullin /= 10;
-					--p;
-				}
-			}
-			else {
-				long long llin = (long long)std::abs(fin);
-				size_t sz{ 0 };
-				while (llin > 0) {
-					llin /= 10;
-					++sz;
-				}
-				_digits = new char[sz];
-				_end = _digits + sz;
-				char* p = _end - 1;
-				llin = (long long)std::abs(fin);
-				while (llin > 0) {
-					*p = '0' + (llin) % 10;
-					llin /= 10;
-					--p;
-				}
-			}
-			if (fin < 0) _sign = false;
+		assign(static_cast<double>(in));
+	}
+}
+
+//转换到整数类型，超出范围时out缩窄到最大值或最小值并返回false，NaN转换为0
+template<typename Int>
+bool BigInt::convert(Int& out) const {
+	unsigned long long magnitude{ 0 };
+	if (isNaN()) {
+		out = 0;
+		return false;
+	}
+	bool fits = magnitude64(magnitude);
+	if constexpr (std::is_unsigned_v<Int>) {
+		if (!_sign) {
+			out = 0;
+			return false;
+		}
+		if (!fits || magnitude > std::numeric_limits<Int>::max()) {
+			out = std::numeric_limits<Int>::max();
+			return false;
+		}
+		out = static_cast<Int>(magnitude);
+	}
+	else {
+		unsigned long long limit = static_cast<unsigned long long>(std::numeric_limits<Int>::max()) + !_sign;
+		if (!fits || magnitude > limit) {
+			out = _sign ? std::numeric_limits<Int>::max() : std::numeric_limits<Int>::min();
+			return false;
 		}
+		//负数的绝对值可能是max + 1，先减一再取反避免溢出
+		out = _sign ? static_cast<Int>(magnitude) : static_cast<Int>(-static_cast<long long>(magnitude - 1) - 1);
+	}
+	return true;
+}
+
+template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool>>
+int BigInt::compare(const Int& r) const {
+	if constexpr (std::is_unsigned_v<Int>) {
+		return compareInteger(static_cast<unsigned long long>(r), true);
+	}
+	else {
+		unsigned long long magnitude = static_cast<unsigned long long>(r);
+		return compareInteger(r < 0 ? 0ull - magnitude : magnitude, r >= 0);
 	}
 }
 
+//与整数比较时不构造临时的BigInt，NaN参与的比较除!=外都为false
+template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+bool operator>(const BigInt& l, const Int& r) { return !l.isNaN() && l.compare(r) > 0; }
+template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+bool operator==(const BigInt& l, const Int& r) { return !l.isNaN() && l.compare(r) == 0; }
+template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+bool operator!=(const BigInt& l, const Int& r) { return !(l == r); }
+template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+bool operator>=(const BigInt& l, const Int& r) { return !l.isNaN() && l.compare(r) >= 0; }
+template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+bool operator<(const BigInt& l, const Int& r) { return !l.isNaN() && l.compare(r) < 0; }
+template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+bool operator<=(const BigInt& l, const Int& r) { return !l.isNaN() && l.compare(r) <= 0; }
+
+template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+bool operator>(const Int& l, const BigInt& r) { return r < l; }
+template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+bool operator==(const Int& l, const BigInt& r) { return r == l; }
+template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+bool operator!=(const Int& l, const BigInt& r) { return r != l; }
+template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+bool operator>=(const Int& l, const BigInt& r) { return r <= l; }
+template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+bool operator<(const Int& l, const BigInt& r) { return r > l; }
+template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+bool operator<=(const Int& l, const BigInt& r) { return r >= l; }
+
 namespace std {
 	template<>
 	struct hash<BigInt> {
-		std::size_t operator()(const BigInt& bInt) const ;
+		//直接在limb上计算，不分配内存
+		std::size_t operator()(const BigInt& bInt) const noexcept;
+	};
+}
+
+//构造时算好哈希值的不可变键，适合反复查找的unordered容器
+//比较相等时先比较哈希值，不同的键大多在这一步就能区分
+class HashedBigInt {
+public:
+	HashedBigInt(const BigInt& value) :_value{ value }, _hash{ std::hash<BigInt>{}(_value) } {}
+	HashedBigInt(BigInt&& value) :_value{ std::move(value) }, _hash{ std::hash<BigInt>{}(_value) } {}
+
+	const BigInt& value() const { return _value; }
+	std::size_t hash() const { return _hash; }
+	operator const BigInt& () const { return _value; }
+
+	friend bool operator==(const HashedBigInt& l, const HashedBigInt& r) { return l._hash == r._hash && l._value == r._value; }
+	friend bool operator!=(const HashedBigInt& l, const HashedBigInt& r) { return !(l == r); }
+private:
+	BigInt _value;
+	std::size_t _hash;
+};
+
+namespace std {
+	template<>
+	struct hash<HashedBigInt> {
+		std::size_t operator()(const HashedBigInt& key) const noexcept { return key.hash(); }
 	};
 }
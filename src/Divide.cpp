@@ -0,0 +1,204 @@
+#include<vector>
+#include<algorithm>
+
+#include"src/Limbs.h"
+
+namespace limbs {
+	void divmodBasecase(limb_t* q, limb_t* r, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		if (bn == 1) {
+			r[0] = divBySingle(q, a, an, b[0]);
+			return;
+		}
+		//规范化使除数最高位为1，这样试商最多偏大2
+		int shift = countLeadingZeros(b[bn - 1]);
+		//字长级别的小除法不分配堆内存
+		limb_t stack_buf[32];
+		std::vector<limb_t> heap_buf;
+		limb_t* vn = stack_buf;
+		if (an + 1 + bn > 32) {
+			heap_buf.resize(an + 1 + bn);
+			vn = heap_buf.data();
+		}
+		limb_t* un = vn + bn;
+		lshift(vn, b, bn, shift);
+		un[an] = lshift(un, a, an, shift);
+		const dlimb_t base = dlimb_t(1) << limb_bits;
+		for (uint32_t j = an - bn + 1; j-- > 0;) {
+			dlimb_t num = (dlimb_t(un[j + bn]) << limb_bits) | un[j + bn - 1];
+			dlimb_t qhat = num / vn[bn - 1];
+			dlimb_t rhat = num % vn[bn - 1];
+			while (qhat >= base || qhat * vn[bn - 2] > ((rhat << limb_bits) | un[j + bn - 2])) {
+				--qhat;
+				rhat += vn[bn - 1];
+				if (rhat >= base) break;
+			}
+			//un[j, j + bn] -= qhat * vn
+			int64_t borrow{ 0 }, t;
+			for (uint32_t i = 0; i < bn; ++i) {
+				dlimb_t p = qhat * vn[i];
+				t = int64_t(un[i + j]) - borrow - int64_t(p & 0xffffffffu);
+				un[i + j] = static_cast<limb_t>(t);
+				borrow = int64_t(p >> limb_bits) - (t >> limb_bits);
+			}
+			t = int64_t(un[j + bn]) - borrow;
+			un[j + bn] = static_cast<limb_t>(t);
+			q[j] = static_cast<limb_t>(qhat);
+			if (t < 0) {
+				//试商大了1，加回一个除数
+				--q[j];
+				limb_t carry = add(un + j, un + j, bn, vn, bn);
+				un[j + bn] += carry;
+			}
+		}
+		rshift(r, un, bn, shift);
+	}
+
+	//求倒数的递归到这个规模以下直接用Knuth算法D
+	constexpr uint32_t reciprocal_basecase = 64;
+
+	//牛顿迭代中使用的无符号整数
+	using Natural = std::vector<limb_t>;
+
+	static void trim(Natural& x) {
+		x.resize(normalizedSize(x.data(), static_cast<uint32_t>(x.size())));
+	}
+
+	static Natural mulNatural(const Natural& x, const Natural& y) {
+		Natural ret(x.size() + y.size());
+		mul(ret.data(), x.data(), static_cast<uint32_t>(x.size()), y.data(), static_cast<uint32_t>(y.size()));
+		trim(ret);
+		return ret;
+	}
+
+	static int compareNatural(const Natural& x, const Natural& y) {
+		return compare(x.data(), static_cast<uint32_t>(x.size()), y.data(), static_cast<uint32_t>(y.size()));
+	}
+
+	static void addNatural(Natural& x, const Natural& y) {
+		if (x.size() < y.size()) x.resize(y.size(), 0);
+		x.push_back(0);
+		add(x.data(), x.data(), static_cast<uint32_t>(x.size()), y.data(), static_cast<uint32_t>(y.size()));
+		trim(x);
+	}
+
+	//要求x >= y
+	static void subNatural(Natural& x, const Natural& y) {
+		sub(x.data(), x.data(), static_cast<uint32_t>(x.size()), y.data(), static_cast<uint32_t>(y.size()));
+		trim(x);
+	}
+
+	static void addOne(Natural& x) {
+		addNatural(x, Natural{ 1 });
+	}
+
+	static void subOne(Natural& x) {
+		subNatural(x, Natural{ 1 });
+	}
+
+	//B^n
+	static Natural powerOfBase(uint32_t n) {
+		Natural ret(n + 1, 0);
+		ret[n] = 1;
+		return ret;
+	}
+
+	//x / B^n
+	static Natural shiftDown(const Natural& x, uint32_t n) {
+		if (x.size() <= n) return Natural();
+		return Natural(x.begin() + n, x.end());
+	}
+
+	//b规范化(最高位为1)且有n个limb，返回floor(B^2n / b)的近似值，误差只有几个单位
+	static Natural approxReciprocal(const Natural& b, uint32_t n) {
+		if (n <= reciprocal_basecase) {
+			Natural num = powerOfBase(2 * n), x(n + 2, 0), rem(n);
+			divmodBasecase(x.data(), rem.data(), num.data(), 2 * n + 1, b.data(), n);
+			trim(x);
+			return x;
+		}
+		//先求高h个limb的倒数，再做一次牛顿迭代: x = x0 + x0 * (B^2n - b * x0) / B^2n
+		//B^2n - b * x0约为B^(2n - h)量级，只保留它的高位参与乘法
+		uint32_t h = (n + 1) / 2;
+		Natural x = approxReciprocal(Natural(b.end() - h, b.end()), h);
+		x.insert(x.begin(), n - h, 0);
+		Natural bx = mulNatural(b, x);
+		Natural full = powerOfBase(2 * n);
+		if (compareNatural(full, bx) >= 0) {
+			subNatural(full, bx);
+			addNatural(x, shiftDown(mulNatural(x, shiftDown(full, n - 1)), n + 1));
+		}
+		else {
+			subNatural(bx, full);
+			subNatural(x, shiftDown(mulNatural(x, shiftDown(bx, n - 1)), n + 1));
+		}
+		return x;
+	}
+
+	//修正到精确的floor(B^2n / b)
+	static Natural reciprocal(const Natural& b, uint32_t n) {
+		Natural x = approxReciprocal(b, n);
+		Natural bx = mulNatural(b, x);
+		Natural full = powerOfBase(2 * n);
+		while (compareNatural(bx, full) > 0) {
+			subOne(x);
+			subNatural(bx, b);
+		}
+		subNatural(full, bx);
+		while (compareNatural(full, b) >= 0) {
+			addOne(x);
+			subNatural(full, b);
+		}
+		return x;
+	}
+
+	//a < b * B^n, 用倒数x = floor(B^2n / b)求商
+	//只用a的高n + 1个limb估计，丢掉的部分对商的影响小于1，估计值最多偏小3
+	static void divChunk(Natural& q, Natural& r, const Natural& a, const Natural& b, const Natural& x, uint32_t n) {
+		q = shiftDown(mulNatural(shiftDown(a, n - 1), x), n + 1);
+		Natural qb = mulNatural(q, b);
+		r = a;
+		while (compareNatural(qb, r) > 0) {
+			subOne(q);
+			subNatural(qb, b);
+		}
+		subNatural(r, qb);
+		while (compareNatural(r, b) >= 0) {
+			addOne(q);
+			subNatural(r, b);
+		}
+	}
+
+	void divmodNewton(limb_t* q, limb_t* r, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		int shift = countLeadingZeros(b[bn - 1]);
+		Natural bs(bn), as(an + 1);
+		lshift(bs.data(), b, bn, shift);
+		as[an] = lshift(as.data(), a, an, shift);
+		Natural x = reciprocal(bs, bn);
+
+		//被除数按bn个limb分块，从高到低每次求出bn个limb的商
+		uint32_t chunks = (an + 1 + bn - 1) / bn;
+		as.resize(chunks * bn, 0);
+		std::fill(q, q + an - bn + 1, 0);
+		Natural rem, qi, cur;
+		for (uint32_t i = chunks; i-- > 0;) {
+			cur.assign(as.begin() + i * bn, as.begin() + (i + 1) * bn);
+			cur.insert(cur.end(), rem.begin(), rem.end());
+			trim(cur);
+			divChunk(qi, rem, cur, bs, x, bn);
+			for (uint32_t j = 0; j < qi.size() && i * bn + j < an - bn + 1; ++j) {
+				q[i * bn + j] = qi[j];
+			}
+		}
+		rem.resize(bn, 0);
+		rshift(r, rem.data(), bn, shift);
+	}
+
+	void divmod(limb_t* q, limb_t* r, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		if (bn >= newton_div_threshold && an - bn >= newton_div_threshold) {
+			divmodNewton(q, r, a, an, b, bn);
+		}
+		else {
+			divmodBasecase(q, r, a, an, b, bn);
+		}
+	}
+}
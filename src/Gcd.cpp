@@ -0,0 +1,442 @@
+#include<vector>
+#include<algorithm>
+#include<utility>
+
+#include"src/Limbs.h"
+
+namespace limbs {
+	//不少于这么多limb的hgcd先递归处理高半部分，以下逐步约简
+	constexpr uint32_t hgcd_threshold = 120;
+	//不少于这么多limb的gcd每次用hgcd约简高1/3，以下使用Lehmer算法
+	constexpr uint32_t gcd_dc_threshold = 400;
+
+	using Natural = std::vector<limb_t>;
+
+	static void trim(Natural& x) {
+		x.resize(normalizedSize(x.data(), static_cast<uint32_t>(x.size())));
+	}
+
+	static uint32_t sizeOf(const Natural& x) {
+		return static_cast<uint32_t>(x.size());
+	}
+
+	static Natural mulNatural(const Natural& x, const Natural& y) {
+		if (x.empty() || y.empty()) return Natural();
+		Natural ret(x.size() + y.size());
+		if (x.size() >= y.size()) mul(ret.data(), x.data(), sizeOf(x), y.data(), sizeOf(y));
+		else mul(ret.data(), y.data(), sizeOf(y), x.data(), sizeOf(x));
+		trim(ret);
+		return ret;
+	}
+
+	static int compareNatural(const Natural& x, const Natural& y) {
+		return compare(x.data(), sizeOf(x), y.data(), sizeOf(y));
+	}
+
+	static void addNatural(Natural& x, const Natural& y) {
+		if (x.size() < y.size()) x.resize(y.size(), 0);
+		x.push_back(0);
+		add(x.data(), x.data(), sizeOf(x), y.data(), sizeOf(y));
+		trim(x);
+	}
+
+	//要求x >= y
+	static void subNatural(Natural& x, const Natural& y) {
+		sub(x.data(), x.data(), sizeOf(x), y.data(), sizeOf(y));
+		trim(x);
+	}
+
+	//x / B^n
+	static Natural shiftDown(const Natural& x, uint32_t n) {
+		if (x.size() <= n) return Natural();
+		return Natural(x.begin() + n, x.end());
+	}
+
+	//x mod B^n
+	static Natural lowPart(const Natural& x, uint32_t n) {
+		Natural ret(x.begin(), x.begin() + std::min(sizeOf(x), n));
+		trim(ret);
+		return ret;
+	}
+
+	//x * B^n
+	static Natural shiftUp(const Natural& x, uint32_t n) {
+		if (x.empty()) return Natural();
+		Natural ret(n, 0);
+		ret.insert(ret.end(), x.begin(), x.end());
+		return ret;
+	}
+
+	//res[0, an) -= a * m, 返回最高位借位
+	static limb_t subMulBySingle(limb_t* res, const limb_t* a, uint32_t an, limb_t m) {
+		limb_t borrow{ 0 };
+		for (uint32_t i = 0; i < an; ++i) {
+			dlimb_t p = dlimb_t(a[i]) * m + borrow;
+			limb_t lo = static_cast<limb_t>(p);
+			borrow = static_cast<limb_t>(p >> limb_bits) + (res[i] < lo);
+			res[i] -= lo;
+		}
+		return borrow;
+	}
+
+	//行列式为1的非负矩阵，(a, b)_原 = M (a, b)_新
+	struct Matrix1 {
+		limb_t u[2][2];
+	};
+
+	struct Matrix {
+		Natural u[2][2]{ { Natural{ 1 }, Natural() }, { Natural(), Natural{ 1 } } };
+	};
+
+	//M = M * m
+	static void mulMatrix1(Matrix& M, const Matrix1& m) {
+		for (auto& row : M.u) {
+			uint32_t n = std::max(sizeOf(row[0]), sizeOf(row[1]));
+			row[0].resize(n, 0);
+			row[1].resize(n, 0);
+			Natural c0(n + 1), c1(n + 1);
+			c0[n] = mulBySingle(c0.data(), row[0].data(), n, m.u[0][0]);
+			c0[n] += addMulBySingle(c0.data(), row[1].data(), n, m.u[1][0]);
+			c1[n] = mulBySingle(c1.data(), row[0].data(), n, m.u[0][1]);
+			c1[n] += addMulBySingle(c1.data(), row[1].data(), n, m.u[1][1]);
+			trim(c0);
+			trim(c1);
+			row[0] = std::move(c0);
+			row[1] = std::move(c1);
+		}
+	}
+
+	//M = M * m
+	static void mulMatrix(Matrix& M, const Matrix& m) {
+		for (auto& row : M.u) {
+			Natural c0 = mulNatural(row[0], m.u[0][0]);
+			addNatural(c0, mulNatural(row[1], m.u[1][0]));
+			Natural c1 = mulNatural(row[0], m.u[0][1]);
+			addNatural(c1, mulNatural(row[1], m.u[1][1]));
+			row[0] = std::move(c0);
+			row[1] = std::move(c1);
+		}
+	}
+
+	//第col列加上q乘另一列，对应另一个数减去q倍的这个数
+	static void updateColumn(Matrix& M, const Natural& q, int col) {
+		for (auto& row : M.u) addNatural(row[col], mulNatural(q, row[1 - col]));
+	}
+
+	//(a, b) = m^(-1) (a, b)，即a = u11 a - u01 b, b = u00 b - u10 a，ta, tb是复用的临时空间
+	static void applyInverse1(Natural& a, Natural& b, const Matrix1& m, Natural& ta, Natural& tb) {
+		uint32_t n = std::max(sizeOf(a), sizeOf(b));
+		a.resize(n, 0);
+		b.resize(n, 0);
+		ta.resize(n + 1);
+		tb.resize(n + 1);
+		ta[n] = mulBySingle(ta.data(), a.data(), n, m.u[1][1]);
+		ta[n] -= subMulBySingle(ta.data(), b.data(), n, m.u[0][1]);
+		tb[n] = mulBySingle(tb.data(), b.data(), n, m.u[0][0]);
+		tb[n] -= subMulBySingle(tb.data(), a.data(), n, m.u[1][0]);
+		trim(ta);
+		trim(tb);
+		std::swap(a, ta);
+		std::swap(b, tb);
+	}
+
+	//只看(ah, al)和(bh, bl)这两个双limb的前缀求出约简矩阵，保证对完整的数也是正确的商序列
+	//做不出任何一步时返回false，与GMP的mpn_hgcd2相同
+	static bool hgcd2(limb_t ah, limb_t al, limb_t bh, limb_t bl, Matrix1& M) {
+		constexpr limb_t half = limb_t(1) << (limb_bits / 2);
+		limb_t h[2]{ ah, bh }, l[2]{ al, bl };
+		if (ah < 2 || bh < 2) return false;
+		auto sub2 = [&](int i) {
+			dlimb_t x = (dlimb_t(h[i]) << limb_bits | l[i]) - (dlimb_t(h[1 - i]) << limb_bits | l[1 - i]);
+			h[i] = static_cast<limb_t>(x >> limb_bits);
+			l[i] = static_cast<limb_t>(x);
+		};
+		//i是这一步被约简的数，另一个数的q倍加到第1 - i列
+		auto update = [&](int i, limb_t q) {
+			M.u[0][1 - i] += q * M.u[0][i];
+			M.u[1][1 - i] += q * M.u[1][i];
+		};
+		int i = ah > bh || (ah == bh && al > bl) ? 0 : 1;
+		sub2(i);
+		if (h[i] < 2) return false;
+		M.u[0][0] = M.u[1][1] = 1;
+		M.u[0][1] = i == 0 ? 1 : 0;
+		M.u[1][0] = i == 0 ? 0 : 1;
+		i = h[0] < h[1] ? 1 : 0;
+
+		//双limb的商
+		for (;;) {
+			int j = 1 - i;
+			if (h[i] == h[j]) return true;
+			if (h[i] < half) {
+				//高位不够半个limb时丢掉低半个limb，改用单limb继续
+				h[0] = (h[0] << (limb_bits / 2)) + (l[0] >> (limb_bits / 2));
+				h[1] = (h[1] << (limb_bits / 2)) + (l[1] >> (limb_bits / 2));
+				break;
+			}
+			sub2(i);
+			if (h[i] < 2) return true;
+			if (h[i] <= h[j]) {
+				update(i, 1);
+			}
+			else {
+				dlimb_t x = dlimb_t(h[i]) << limb_bits | l[i], y = dlimb_t(h[j]) << limb_bits | l[j];
+				limb_t q = static_cast<limb_t>(x / y);
+				x %= y;
+				h[i] = static_cast<limb_t>(x >> limb_bits);
+				l[i] = static_cast<limb_t>(x);
+				//余数太小时少减一次，商q仍然正确
+				if (h[i] < 2) {
+					update(i, q);
+					return true;
+				}
+				update(i, q + 1);
+			}
+			i = j;
+		}
+		//单limb的商
+		for (;;) {
+			int j = 1 - i;
+			h[i] -= h[j];
+			if (h[i] < 2 * half) return true;
+			if (h[i] <= h[j]) {
+				update(i, 1);
+			}
+			else {
+				limb_t q = h[i] / h[j];
+				h[i] -= q * h[j];
+				if (h[i] < 2 * half) {
+					update(i, q);
+					return true;
+				}
+				update(i, q + 1);
+			}
+			i = j;
+		}
+	}
+
+	//x在第n个limb处的值，缺少的limb当作0
+	static limb_t limbAt(const Natural& x, uint32_t n) {
+		return n < x.size() ? x[n] : 0;
+	}
+
+	//a, b的最高两个limb，n > 2时左移到最高位为1
+	static void topLimbs(const Natural& a, const Natural& b, uint32_t n, bool shift, limb_t& ah, limb_t& al, limb_t& bh, limb_t& bl) {
+		ah = limbAt(a, n - 1);
+		al = limbAt(a, n - 2);
+		bh = limbAt(b, n - 1);
+		bl = limbAt(b, n - 2);
+		limb_t mask = ah | bh;
+		if (!shift || (mask >> (limb_bits - 1))) return;
+		int s = countLeadingZeros(mask);
+		ah = (ah << s) | (al >> (limb_bits - s));
+		bh = (bh << s) | (bl >> (limb_bits - s));
+		al = (al << s) | (limbAt(a, n - 3) >> (limb_bits - s));
+		bl = (bl << s) | (limbAt(b, n - 3) >> (limb_bits - s));
+	}
+
+	//一次减法再加一次带余除法(GMP的gcd_subdiv_step)，M不为空时记录商
+	//s > 0时要求结果都多于s个limb，做不到就不修改并返回false
+	//s == 0时返回false表示a, b中已经有一个是0
+	static bool subdivStep(Natural& a, Natural& b, uint32_t s, Matrix* M) {
+		//*y -= q * (*x)，y是b时更新第0列，是a时更新第1列
+		Natural* x = &a;
+		Natural* y = &b;
+		int col{ 0 };
+		auto record = [&](const Natural& q) {
+			if (M) updateColumn(*M, q, col);
+		};
+		int c = compareNatural(a, b);
+		if (c == 0) {
+			if (s > 0) return false;
+			record(Natural{ 1 });
+			b.clear();
+			return false;
+		}
+		if (c > 0) {
+			std::swap(x, y);
+			col = 1;
+		}
+		if (sizeOf(*x) <= s) return false;
+		subNatural(*y, *x);
+		if (sizeOf(*y) <= s) {
+			addNatural(*y, *x);
+			return false;
+		}
+		record(Natural{ 1 });
+		c = compareNatural(*x, *y);
+		if (c == 0) {
+			if (s > 0) return true;
+			record(Natural{ 1 });
+			y->clear();
+			return false;
+		}
+		if (c > 0) {
+			std::swap(x, y);
+			col = 1 - col;
+		}
+		uint32_t xn{ sizeOf(*x) }, yn{ sizeOf(*y) };
+		Natural q(yn - xn + 1), r(xn);
+		divmod(q.data(), r.data(), y->data(), yn, x->data(), xn);
+		trim(q);
+		trim(r);
+		if (sizeOf(r) <= s) {
+			if (s == 0) {
+				record(q);
+				y->clear();
+				return false;
+			}
+			//余数太小，商减1，余数加回一个x
+			subNatural(q, Natural{ 1 });
+			addNatural(r, *x);
+		}
+		record(q);
+		*y = std::move(r);
+		return true;
+	}
+
+	//hgcd的一步：先试hgcd2，失败时做一次subdivStep
+	static bool hgcdStep(Natural& a, Natural& b, uint32_t s, Matrix& M, Natural& ta, Natural& tb) {
+		uint32_t n = std::max(sizeOf(a), sizeOf(b));
+		limb_t ah, al, bh, bl;
+		//n == s + 1时不移位，否则hgcd2可能约简得太多
+		topLimbs(a, b, n, n > s + 1, ah, al, bh, bl);
+		Matrix1 m;
+		if ((n > s + 1 || (ah | bh) >= 4) && hgcd2(ah, al, bh, bl, m)) {
+			mulMatrix1(M, m);
+			applyInverse1(a, b, m, ta, tb);
+			return true;
+		}
+		return subdivStep(a, b, s, &M);
+	}
+
+	static bool hgcd(Natural& a, Natural& b, Matrix& M);
+
+	//对a, b去掉低p个limb后的部分求hgcd，再把矩阵作用到完整的a, b上(Möller的引理保证这样仍然正确)
+	static bool hgcdReduce(Natural& a, Natural& b, Matrix& M, uint32_t p) {
+		Natural ah = shiftDown(a, p), bh = shiftDown(b, p);
+		Matrix M1;
+		if (!hgcd(ah, bh, M1)) return false;
+		//a = ah * B^p + u11 al - u01 bl, b = bh * B^p + u00 bl - u10 al
+		Natural al = lowPart(a, p), bl = lowPart(b, p);
+		a = shiftUp(ah, p);
+		addNatural(a, mulNatural(M1.u[1][1], al));
+		subNatural(a, mulNatural(M1.u[0][1], bl));
+		b = shiftUp(bh, p);
+		addNatural(b, mulNatural(M1.u[0][0], bl));
+		subNatural(b, mulNatural(M1.u[1][0], al));
+		mulMatrix(M, M1);
+		return true;
+	}
+
+	//n = max(a, b的长度)，约简到|a - b|不超过s = n / 2 + 1个limb，同时a, b都多于s个limb
+	//M的初值为单位阵，没有可做的约简时返回false，o(M(n)logn)
+	static bool hgcd(Natural& a, Natural& b, Matrix& M) {
+		uint32_t n = std::max(sizeOf(a), sizeOf(b));
+		uint32_t s = n / 2 + 1;
+		if (n <= s) return false;
+		bool success{ false };
+		Natural ta, tb;
+		if (n >= hgcd_threshold) {
+			//先用高半部分的hgcd把长度降到3n / 4左右
+			success = hgcdReduce(a, b, M, n / 2);
+			while (std::max(sizeOf(a), sizeOf(b)) > 3 * n / 4 + 1) {
+				if (!hgcdStep(a, b, s, M, ta, tb)) return success;
+				success = true;
+			}
+			//再递归一次降到s附近
+			uint32_t m = std::max(sizeOf(a), sizeOf(b));
+			if (m > s + 2) {
+				Matrix M1;
+				if (hgcdReduce(a, b, M1, 2 * s - m + 1)) {
+					mulMatrix(M, M1);
+					success = true;
+				}
+			}
+		}
+		while (hgcdStep(a, b, s, M, ta, tb)) success = true;
+		return success;
+	}
+
+	static int countTrailingZeros64(uint64_t x) {
+		limb_t lo = static_cast<limb_t>(x);
+		return lo ? countTrailingZeros(lo) : limb_bits + countTrailingZeros(static_cast<limb_t>(x >> limb_bits));
+	}
+
+	//二进制gcd，只用移位和减法
+	static uint64_t binaryGcd(uint64_t u, uint64_t v) {
+		if (u == 0) return v;
+		if (v == 0) return u;
+		int shift = countTrailingZeros64(u | v);
+		u >>= countTrailingZeros64(u);
+		do {
+			v >>= countTrailingZeros64(v);
+			if (u > v) std::swap(u, v);
+			v -= u;
+		} while (v);
+		return u << shift;
+	}
+
+	//结束时a, b中有一个是0，另一个就是gcd；M不为空时(a, b)_原 = M (a, b)_新
+	static void gcdNatural(Natural& a, Natural& b, Matrix* M) {
+		Natural ta, tb;
+		while (!a.empty() && !b.empty()) {
+			uint32_t n = std::max(sizeOf(a), sizeOf(b));
+			//长度相差较多时先做一次除法
+			if (std::min(sizeOf(a), sizeOf(b)) + 1 < n) {
+				subdivStep(a, b, 0, M);
+				continue;
+			}
+			if (n >= gcd_dc_threshold) {
+				Matrix M1;
+				if (hgcdReduce(a, b, M1, 2 * n / 3)) {
+					if (M) mulMatrix(*M, M1);
+					continue;
+				}
+			}
+			else if (n <= 2 && !M) {
+				dlimb_t u = dlimb_t(limbAt(a, 1)) << limb_bits | limbAt(a, 0);
+				dlimb_t v = dlimb_t(limbAt(b, 1)) << limb_bits | limbAt(b, 0);
+				dlimb_t g = binaryGcd(u, v);
+				a = Natural{ static_cast<limb_t>(g), static_cast<limb_t>(g >> limb_bits) };
+				trim(a);
+				b.clear();
+				return;
+			}
+			else if (n > 2) {
+				limb_t ah, al, bh, bl;
+				topLimbs(a, b, n, true, ah, al, bh, bl);
+				Matrix1 m;
+				if (hgcd2(ah, al, bh, bl, m)) {
+					if (M) mulMatrix1(*M, m);
+					applyInverse1(a, b, m, ta, tb);
+					continue;
+				}
+			}
+			subdivStep(a, b, 0, M);
+		}
+	}
+
+	uint32_t gcd(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		Natural x(a, a + an), y(b, b + bn);
+		gcdNatural(x, y, nullptr);
+		Natural& g = x.empty() ? y : x;
+		std::copy(g.begin(), g.end(), res);
+		return sizeOf(g);
+	}
+
+	uint32_t gcdext(limb_t* g, limb_t* x, uint32_t& xn, bool& x_negative, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		Natural u(a, a + an), v(b, b + bn);
+		Matrix M;
+		gcdNatural(u, v, &M);
+		//v == 0时g = u11 a - u01 b，u == 0时g = u00 b - u10 a
+		x_negative = u.empty();
+		const Natural& cofactor = u.empty() ? M.u[1][0] : M.u[1][1];
+		const Natural& d = u.empty() ? v : u;
+		std::copy(cofactor.begin(), cofactor.end(), x);
+		xn = sizeOf(cofactor);
+		if (xn == 0) x_negative = false;
+		std::copy(d.begin(), d.end(), g);
+		return sizeOf(d);
+	}
+}
@@ -0,0 +1,400 @@
+#include<algorithm>
+#include<cstring>
+#if defined(_M_X64) || defined(__x86_64__)
+#define BIGINT_X64
+#include<immintrin.h>
+#endif
+
+#include"src/Limbs.h"
+
+#if defined(BIGINT_X64) && !defined(_MSC_VER)
+//gcc/clang需要为单个函数打开avx2，msvc可以直接使用所有intrinsic
+#define BIGINT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define BIGINT_TARGET_AVX2
+#endif
+
+namespace limbs {
+	uint32_t normalizedSize(const limb_t* a, uint32_t n) {
+		while (n > 0 && a[n - 1] == 0) --n;
+		return n;
+	}
+
+	static inline uint64_t load64(const limb_t* p) {
+		uint64_t x;
+		std::memcpy(&x, p, sizeof(x));
+		return x;
+	}
+
+	static inline void store64(limb_t* p, uint64_t x) {
+		std::memcpy(p, &x, sizeof(x));
+	}
+
+#if defined(BIGINT_X64)
+	//64 * 64 -> 128位乘法，返回低64位
+	static inline uint64_t mul64(uint64_t a, uint64_t b, uint64_t* high) {
+#if defined(_MSC_VER)
+		return _umul128(a, b, high);
+#else
+		unsigned __int128 p = static_cast<unsigned __int128>(a) * b;
+		*high = static_cast<uint64_t>(p >> 64);
+		return static_cast<uint64_t>(p);
+#endif
+	}
+
+	//a[0, n)与b[0, n)从高位向低位找第一个不同的limb，返回下标 + 1，全部相同时返回0
+	BIGINT_TARGET_AVX2 static uint32_t highestDifferenceAVX2(const limb_t* a, const limb_t* b, uint32_t n) {
+		for (; n >= 8; n -= 8) {
+			__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + n - 8));
+			__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + n - 8));
+			uint32_t diff = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(x, y)));
+			if (diff) return n - 8 + (31 - countLeadingZeros(diff)) / 4 + 1;
+		}
+		for (; n > 0; --n) {
+			if (a[n - 1] != b[n - 1]) return n;
+		}
+		return 0;
+	}
+
+	static uint32_t highestDifferenceSSE2(const limb_t* a, const limb_t* b, uint32_t n) {
+		for (; n >= 4; n -= 4) {
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + n - 4));
+			__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + n - 4));
+			uint32_t diff = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi32(x, y))) & 0xffffu;
+			if (diff) return n - 4 + (31 - countLeadingZeros(diff)) / 4 + 1;
+		}
+		for (; n > 0; --n) {
+			if (a[n - 1] != b[n - 1]) return n;
+		}
+		return 0;
+	}
+
+	static bool hasAVX2() {
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7) return false;
+		__cpuid(info, 1);
+		//osxsave和avx，并确认操作系统保存了ymm寄存器
+		if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return false;
+		if ((_xgetbv(0) & 6) != 6) return false;
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+
+	//启动时按cpu选择一次
+	static uint32_t(* const highestDifference)(const limb_t*, const limb_t*, uint32_t) = hasAVX2() ? highestDifferenceAVX2 : highestDifferenceSSE2;
+#else
+	static uint32_t highestDifference(const limb_t* a, const limb_t* b, uint32_t n) {
+		for (; n > 0; --n) {
+			if (a[n - 1] != b[n - 1]) return n;
+		}
+		return 0;
+	}
+#endif
+
+	int compare(const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		if (an != bn) return an > bn ? 1 : -1;
+		uint32_t i = highestDifference(a, b, an);
+		if (i == 0) return 0;
+		return a[i - 1] > b[i - 1] ? 1 : -1;
+	}
+
+	limb_t add(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		uint32_t i{ 0 };
+#if defined(BIGINT_X64)
+		//每次用adc处理两个limb
+		unsigned char c{ 0 };
+		for (; i + 2 <= bn; i += 2) {
+			unsigned long long sum;
+			c = _addcarry_u64(c, load64(a + i), load64(b + i), &sum);
+			store64(res + i, sum);
+		}
+		dlimb_t carry{ c };
+#else
+		dlimb_t carry{ 0 };
+#endif
+		for (; i < bn; ++i) {
+			carry += dlimb_t(a[i]) + b[i];
+			res[i] = limb_t(carry);
+			carry >>= limb_bits;
+		}
+		//进位消失后剩下的部分直接拷贝
+		for (; carry && i < an; ++i) {
+			carry += a[i];
+			res[i] = limb_t(carry);
+			carry >>= limb_bits;
+		}
+		if (res != a && i < an) std::memmove(res + i, a + i, (an - i) * sizeof(limb_t));
+		return limb_t(carry);
+	}
+
+	limb_t sub(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		uint32_t i{ 0 };
+#if defined(BIGINT_X64)
+		unsigned char c{ 0 };
+		for (; i + 2 <= bn; i += 2) {
+			unsigned long long diff;
+			c = _subborrow_u64(c, load64(a + i), load64(b + i), &diff);
+			store64(res + i, diff);
+		}
+		limb_t borrow{ c };
+#else
+		limb_t borrow{ 0 };
+#endif
+		for (; i < bn; ++i) {
+			dlimb_t diff = dlimb_t(a[i]) - b[i] - borrow;
+			res[i] = limb_t(diff);
+			borrow = limb_t(diff >> limb_bits) & 1;
+		}
+		for (; borrow && i < an; ++i) {
+			dlimb_t diff = dlimb_t(a[i]) - borrow;
+			res[i] = limb_t(diff);
+			borrow = limb_t(diff >> limb_bits) & 1;
+		}
+		if (res != a && i < an) std::memmove(res + i, a + i, (an - i) * sizeof(limb_t));
+		return borrow;
+	}
+
+	limb_t mulBySingle(limb_t* res, const limb_t* a, uint32_t an, limb_t m) {
+		uint32_t i{ 0 };
+#if defined(BIGINT_X64)
+		//两个limb拼成64位一起乘，进位小于2^32
+		uint64_t word_carry{ 0 };
+		for (; i + 2 <= an; i += 2) {
+			uint64_t high, low = mul64(load64(a + i), m, &high);
+			low += word_carry;
+			high += low < word_carry;
+			store64(res + i, low);
+			word_carry = high;
+		}
+		dlimb_t carry{ word_carry };
+#else
+		dlimb_t carry{ 0 };
+#endif
+		for (; i < an; ++i) {
+			carry += dlimb_t(a[i]) * m;
+			res[i] = limb_t(carry);
+			carry >>= limb_bits;
+		}
+		return limb_t(carry);
+	}
+
+	limb_t addMulBySingle(limb_t* res, const limb_t* a, uint32_t an, limb_t m) {
+		uint32_t i{ 0 };
+#if defined(BIGINT_X64)
+		uint64_t word_carry{ 0 };
+		for (; i + 2 <= an; i += 2) {
+			uint64_t high, low = mul64(load64(a + i), m, &high);
+			uint64_t r = load64(res + i);
+			low += r;
+			high += low < r;
+			low += word_carry;
+			high += low < word_carry;
+			store64(res + i, low);
+			word_carry = high;
+		}
+		dlimb_t carry{ word_carry };
+#else
+		dlimb_t carry{ 0 };
+#endif
+		for (; i < an; ++i) {
+			carry += dlimb_t(a[i]) * m + res[i];
+			res[i] = limb_t(carry);
+			carry >>= limb_bits;
+		}
+		return limb_t(carry);
+	}
+
+	limb_t divBySingle(limb_t* quo, const limb_t* a, uint32_t an, limb_t d) {
+		dlimb_t rem{ 0 };
+		while (an > 0) {
+			--an;
+			rem = (rem << limb_bits) | a[an];
+			quo[an] = limb_t(rem / d);
+			rem %= d;
+		}
+		return limb_t(rem);
+	}
+
+	limb_t lshift(limb_t* res, const limb_t* a, uint32_t an, int shift) {
+		if (an == 0) return 0;
+		if (shift == 0) {
+			for (uint32_t i = 0; i < an; ++i) res[i] = a[i];
+			return 0;
+		}
+		limb_t out = a[an - 1] >> (limb_bits - shift);
+		for (uint32_t i = an - 1; i > 0; --i) {
+			res[i] = (a[i] << shift) | (a[i - 1] >> (limb_bits - shift));
+		}
+		res[0] = a[0] << shift;
+		return out;
+	}
+
+	limb_t rshift(limb_t* res, const limb_t* a, uint32_t an, int shift) {
+		if (an == 0) return 0;
+		if (shift == 0) {
+			for (uint32_t i = 0; i < an; ++i) res[i] = a[i];
+			return 0;
+		}
+		limb_t out = a[0] << (limb_bits - shift);
+		for (uint32_t i = 0; i + 1 < an; ++i) {
+			res[i] = (a[i] >> shift) | (a[i + 1] << (limb_bits - shift));
+		}
+		res[an - 1] = a[an - 1] >> shift;
+		return out;
+	}
+
+	//少于这么多limb时交叉项省下的乘法抵不上加倍和对角线的额外遍历，平方直接用mulMontgomery
+	constexpr uint32_t sqr_montgomery_threshold = 24;
+
+	//CIOS: 每轮先加上a * b[i]，再加上u * m让最低的字变成0并右移一个字
+	//中间结果t < 2m，最高位的字单独放在top中
+#if defined(BIGINT_X64)
+	static inline uint64_t mulAdd64(uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t* high) {
+		//a * b + c + d < 2^128
+		uint64_t low = mul64(a, b, high);
+		low += c;
+		*high += low < c;
+		low += d;
+		*high += low < d;
+		return low;
+	}
+
+	void mulMontgomery(limb_t* res, const limb_t* a, const limb_t* b, const limb_t* m, uint32_t n, uint64_t inv, limb_t* scratch) {
+		//按64位的字计算，乘法次数是32位limb的四分之一
+		uint32_t w = n / 2;
+		limb_t* t = scratch;
+		std::fill(t, t + n, 0);
+		uint64_t top{ 0 };
+		for (uint32_t i = 0; i < w; ++i) {
+			uint64_t bi = load64(b + 2 * i), carry{ 0 }, high;
+			for (uint32_t j = 0; j < w; ++j) {
+				store64(t + 2 * j, mulAdd64(load64(a + 2 * j), bi, load64(t + 2 * j), carry, &high));
+				carry = high;
+			}
+			top += carry;
+			uint64_t top2 = top < carry;
+			uint64_t u = load64(t) * inv;
+			mulAdd64(u, load64(m), load64(t), 0, &carry);
+			for (uint32_t j = 1; j < w; ++j) {
+				store64(t + 2 * (j - 1), mulAdd64(u, load64(m + 2 * j), load64(t + 2 * j), carry, &high));
+				carry = high;
+			}
+			top += carry;
+			store64(t + 2 * (w - 1), top);
+			top = top2 + (top < carry);
+		}
+		if (top || compare(t, normalizedSize(t, n), m, normalizedSize(m, n)) >= 0) sub(t, t, n, m, n);
+		std::copy(t, t + n, res);
+	}
+
+	void redcMontgomery(limb_t* res, limb_t* t, const limb_t* m, uint32_t n, uint64_t inv) {
+		//每轮加上u * m让第i个字变成0，进位累积在top中，对应t的第i + w个字之上
+		uint32_t w = n / 2;
+		uint64_t top{ 0 };
+		for (uint32_t i = 0; i < w; ++i) {
+			uint64_t u = load64(t + 2 * i) * inv, carry{ 0 }, high;
+			for (uint32_t j = 0; j < w; ++j) {
+				store64(t + 2 * (i + j), mulAdd64(u, load64(m + 2 * j), load64(t + 2 * (i + j)), carry, &high));
+				carry = high;
+			}
+			uint64_t s = load64(t + 2 * (i + w)) + top;
+			top = s < top;
+			s += carry;
+			top += s < carry;
+			store64(t + 2 * (i + w), s);
+		}
+		limb_t* r = t + n;
+		if (top || compare(r, normalizedSize(r, n), m, normalizedSize(m, n)) >= 0) sub(r, r, n, m, n);
+		std::copy(r, r + n, res);
+	}
+
+	void sqrMontgomery(limb_t* res, const limb_t* a, const limb_t* m, uint32_t n, uint64_t inv, limb_t* scratch) {
+		if (n < sqr_montgomery_threshold) {
+			mulMontgomery(res, a, a, m, n, inv, scratch);
+			return;
+		}
+		uint32_t w = n / 2;
+		limb_t* t = scratch;
+		//交叉项a[i] * a[j](i < j)只算一次，加倍后再加上对角线a[i]^2，乘法次数是mulMontgomery乘积部分的一半
+		std::fill(t, t + 2 * n, 0);
+		for (uint32_t i = 0; i + 1 < w; ++i) {
+			uint64_t ai = load64(a + 2 * i), carry{ 0 }, high;
+			for (uint32_t j = i + 1; j < w; ++j) {
+				store64(t + 2 * (i + j), mulAdd64(ai, load64(a + 2 * j), load64(t + 2 * (i + j)), carry, &high));
+				carry = high;
+			}
+			store64(t + 2 * (i + w), carry);
+		}
+		lshift(t, t, 2 * n, 1);
+		uint64_t carry{ 0 };
+		for (uint32_t i = 0; i < w; ++i) {
+			uint64_t ai = load64(a + 2 * i), high;
+			store64(t + 4 * i, mulAdd64(ai, ai, load64(t + 4 * i), carry, &high));
+			uint64_t s = load64(t + 4 * i + 2) + high;
+			carry = s < high;
+			store64(t + 4 * i + 2, s);
+		}
+		redcMontgomery(res, t, m, n, inv);
+	}
+#else
+	void mulMontgomery(limb_t* res, const limb_t* a, const limb_t* b, const limb_t* m, uint32_t n, uint64_t inv, limb_t* scratch) {
+		limb_t* t = scratch;
+		std::fill(t, t + n, 0);
+		dlimb_t top{ 0 };
+		for (uint32_t i = 0; i < n; ++i) {
+			dlimb_t carry{ 0 };
+			for (uint32_t j = 0; j < n; ++j) {
+				carry += dlimb_t(a[j]) * b[i] + t[j];
+				t[j] = limb_t(carry);
+				carry >>= limb_bits;
+			}
+			top += carry;
+			limb_t u = t[0] * limb_t(inv);
+			carry = (dlimb_t(u) * m[0] + t[0]) >> limb_bits;
+			for (uint32_t j = 1; j < n; ++j) {
+				carry += dlimb_t(u) * m[j] + t[j];
+				t[j - 1] = limb_t(carry);
+				carry >>= limb_bits;
+			}
+			top += carry;
+			t[n - 1] = limb_t(top);
+			top >>= limb_bits;
+		}
+		if (top || compare(t, normalizedSize(t, n), m, normalizedSize(m, n)) >= 0) sub(t, t, n, m, n);
+		std::copy(t, t + n, res);
+	}
+
+	void redcMontgomery(limb_t* res, limb_t* t, const limb_t* m, uint32_t n, uint64_t inv) {
+		dlimb_t top{ 0 };
+		for (uint32_t i = 0; i < n; ++i) {
+			limb_t u = t[i] * limb_t(inv);
+			dlimb_t carry{ 0 };
+			for (uint32_t j = 0; j < n; ++j) {
+				carry += dlimb_t(u) * m[j] + t[i + j];
+				t[i + j] = limb_t(carry);
+				carry >>= limb_bits;
+			}
+			top += carry + t[i + n];
+			t[i + n] = limb_t(top);
+			top >>= limb_bits;
+		}
+		limb_t* r = t + n;
+		if (top || compare(r, normalizedSize(r, n), m, normalizedSize(m, n)) >= 0) sub(r, r, n, m, n);
+		std::copy(r, r + n, res);
+	}
+
+	void sqrMontgomery(limb_t* res, const limb_t* a, const limb_t* m, uint32_t n, uint64_t inv, limb_t* scratch) {
+		if (n < sqr_montgomery_threshold) {
+			mulMontgomery(res, a, a, m, n, inv, scratch);
+			return;
+		}
+		sqr(scratch, a, n);
+		redcMontgomery(res, scratch, m, n, inv);
+	}
+#endif
+}
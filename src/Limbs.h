@@ -0,0 +1,203 @@
+#pragma once
+#include<cstdint>
+#include<cstddef>
+#include<functional>
+#include<vector>
+#if defined(_MSC_VER)
+#include<intrin.h>
+#endif
+
+//limb级别的底层运算，所有数组均为小端序（低位limb在前）
+namespace limbs {
+	using limb_t = uint32_t;
+	using dlimb_t = uint64_t;
+	constexpr int limb_bits = 32;
+
+	//去掉高位的0，返回有效长度
+	uint32_t normalizedSize(const limb_t* a, uint32_t n);
+
+	//x != 0
+	inline int countLeadingZeros(limb_t x) {
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, x);
+		return 31 - static_cast<int>(index);
+#else
+		return __builtin_clz(x);
+#endif
+	}
+
+	//x != 0
+	inline int countTrailingZeros(limb_t x) {
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, x);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctz(x);
+#endif
+	}
+
+	inline int popCount(limb_t x) {
+#if defined(_MSC_VER)
+		//__popcnt要求CPU支持POPCNT指令，这里用不依赖指令集的并行计数
+		x = x - ((x >> 1) & 0x55555555u);
+		x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+		return static_cast<int>((((x + (x >> 4)) & 0x0f0f0f0fu) * 0x01010101u) >> 24);
+#else
+		return __builtin_popcount(x);
+#endif
+	}
+
+	//a, b必须是规范化的长度
+	int compare(const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+
+	//res[0, an) = a + b, 要求an >= bn, 返回最高位进位
+	limb_t add(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+	//res[0, an) = a - b, 要求a >= b, 返回借位
+	limb_t sub(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+
+	//res[0, an) = a * m, 返回最高位进位
+	limb_t mulBySingle(limb_t* res, const limb_t* a, uint32_t an, limb_t m);
+	//res[0, an) += a * m, 返回最高位进位
+	limb_t addMulBySingle(limb_t* res, const limb_t* a, uint32_t an, limb_t m);
+	//quo[0, an) = a / d, 返回余数
+	limb_t divBySingle(limb_t* quo, const limb_t* a, uint32_t an, limb_t d);
+
+	//res[0, an) = a << shift, 0 <= shift < 32, 返回移出的高位
+	limb_t lshift(limb_t* res, const limb_t* a, uint32_t an, int shift);
+	//res[0, an) = a >> shift, 0 <= shift < 32, 返回移出的低位(在高位对齐)
+	limb_t rshift(limb_t* res, const limb_t* a, uint32_t an, int shift);
+
+	//Montgomery乘法: res[0, n) = a * b / 2^(32n) mod m，res可以与a, b相同
+	//要求n为偶数，m为奇数，a, b < m，inv = -m^(-1) mod 2^64，scratch至少n个limb
+	void mulMontgomery(limb_t* res, const limb_t* a, const limb_t* b, const limb_t* m, uint32_t n, uint64_t inv, limb_t* scratch);
+	//Montgomery约简: res[0, n) = t / 2^(32n) mod m，t[0, 2n)会被改写，要求t < m * 2^(32n)
+	//配合sqr或mul使用，平方时比mulMontgomery少做约一半的乘法
+	void redcMontgomery(limb_t* res, limb_t* t, const limb_t* m, uint32_t n, uint64_t inv);
+	//Montgomery平方: res[0, n) = a * a / 2^(32n) mod m，res可以与a相同，要求同mulMontgomery，scratch至少2n个limb
+	void sqrMontgomery(limb_t* res, const limb_t* a, const limb_t* m, uint32_t n, uint64_t inv, limb_t* scratch);
+
+	//'0'-'9', 'a'-'z'(不区分大小写)对应0-35，其它字符返回36
+	inline int digitValue(char c) {
+		if (c >= '0' && c <= '9') return c - '0';
+		if (c >= 'a' && c <= 'z') return c - 'a' + 10;
+		if (c >= 'A' && c <= 'Z') return c - 'A' + 10;
+		return 36;
+	}
+
+	//进制转换，2 <= radix <= 36，非2的幂的进制用分治转换，o(M(n)logn)
+	//n位radix进制数字至多需要的limb个数
+	uint32_t limbsForDigits(size_t n, int radix);
+	//an个limb至多需要的radix进制位数
+	size_t digitsForLimbs(uint32_t an, int radix);
+	//a至少有的radix进制位数，与实际位数最多差2
+	size_t minDigits(const limb_t* a, uint32_t an, int radix);
+	//a的radix进制位数，a为0时返回1；先由最高几个limb的对数估计，只有a接近radix的整次幂时才与缓存的幂表求出的radix^k比较一次
+	size_t countDigits(const limb_t* a, uint32_t an, int radix);
+	//[first, last)是高位在前的合法数字，res至少有limbsForDigits个limb，返回规范化的长度
+	uint32_t fromChars(limb_t* res, const char* first, const char* last, int radix);
+	//流式的进制转换：高位在前逐个追加数字，只保存已经转换好的limb而不保存整个数字串
+	//每凑满一块(chunk_digits * 32位)转换一次，长度相同的段两两合并，总代价与fromChars相同
+	class DigitAccumulator {
+	public:
+		static constexpr size_t max_block_digits = 1024;
+
+		explicit DigitAccumulator(int radix);
+		//c必须是合法数字
+		void push(char c) {
+			_digits[_len++] = c;
+			if (_len == _block) flush();
+		}
+		//已追加的数字个数
+		size_t digits() const { return _total + _len; }
+		//结果至多需要的limb个数
+		uint32_t size() const { return limbsForDigits(digits(), _radix); }
+		//res至少size()个limb，返回规范化的长度；只有一块以内的数字时不分配内存
+		uint32_t finish(limb_t* res);
+	private:
+		struct Segment {
+			uint32_t level;
+			std::vector<limb_t> limbs;
+		};
+		void flush();
+
+		int _radix;
+		size_t _block;
+		size_t _len{ 0 };
+		size_t _total{ 0 };
+		std::vector<Segment> _segments;
+		char _digits[max_block_digits];
+	};
+	//写满res[0, len)，高位在前，多余的高位补'0'
+	//len少于实际位数时只写入低len位并返回false
+	bool toChars(char* res, size_t len, const limb_t* a, uint32_t an, int radix);
+
+	//超过这个长度(an + bn个limb)的乘法改用精确的ntt，double精度的fft在每个操作数2^17个limb时已经会舍入出错
+	constexpr uint32_t ntt_threshold = 32768;
+
+	//乘法分级的阈值，均以较短操作数的limb个数计
+	struct MulThresholds {
+		uint32_t karatsuba;
+		uint32_t toom3;
+		uint32_t fft;
+	};
+	MulThresholds mulThresholds();
+	void setMulThresholds(const MulThresholds& thresholds);
+	//实测各级算法的交叉点并设为当前阈值
+	MulThresholds tuneMulThresholds();
+
+	//并行设置，threads是参与计算的线程数(包括调用线程)，1表示完全串行(默认)
+	//子问题(较短的操作数、karatsuba/toom-3的子乘积、变换的长度)不少于threshold个limb时才并行
+	struct ParallelConfig {
+		uint32_t threads;
+		uint32_t threshold;
+	};
+	ParallelConfig parallelConfig();
+	//会重建线程池，不能在乘除法进行中调用
+	void setParallelConfig(const ParallelConfig& config);
+	bool useParallel(uint32_t n);
+	uint32_t parallelThreads();
+	//执行task(0), ..., task(n - 1)，调用线程也参与，全部完成后返回；可以嵌套调用
+	void parallelFor(uint32_t n, const std::function<void(uint32_t)>& task);
+	//把[0, n)按线程数均分，每段调用一次task(first, last)
+	void parallelRange(uint32_t n, const std::function<void(uint32_t, uint32_t)>& task);
+
+	//res[0, an + bn) = a * b, res不能与a, b重叠
+	//mul按规模分派；直接调用karatsuba和toom-3时较长的操作数不能超过较短的两倍
+	void mul(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+	void mulBasecase(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+	void mulKaratsuba(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+	void mulToom3(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+	void mulFFT(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+	void mulNTT(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+	//res[0, 2an) = a^2, res不能与a重叠；mul的两个操作数是同一段内存时也会转到这里
+	void sqr(limb_t* res, const limb_t* a, uint32_t an);
+	void sqrBasecase(limb_t* res, const limb_t* a, uint32_t an);
+	void sqrFFT(limb_t* res, const limb_t* a, uint32_t an);
+
+	//商和余数同时求出: q[0, an - bn + 1) = a / b, r[0, bn) = a % b
+	//要求an >= bn >= 1且b[bn - 1] != 0，q, r不能与a, b重叠
+	void divmod(limb_t* q, limb_t* r, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+	//Knuth算法D, o(an * bn)
+	void divmodBasecase(limb_t* q, limb_t* r, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+	//牛顿迭代求倒数后用乘法求商, o(M(n))
+	void divmodNewton(limb_t* q, limb_t* r, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+	//除数和商都不少于这么多limb时使用牛顿迭代
+	constexpr uint32_t newton_div_threshold = 1536;
+
+	//最大公约数，a, b都不为0，res至少min(an, bn)个limb，返回gcd的长度
+	//Lehmer算法每次用最高两个limb求出约简矩阵，很长时用half-gcd递归，o(M(n)logn)
+	uint32_t gcd(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+	//同时求出a * x + b * y = gcd中的x，a, b都不为0，g至少min(an, bn)个limb，x至少bn个limb
+	//x的长度写入xn，符号写入x_negative，|x| <= b / gcd，返回gcd的长度
+	uint32_t gcdext(limb_t* g, limb_t* x, uint32_t& xn, bool& x_negative, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn);
+
+	//res = floor(a^(1/n))，n >= 1，a不为0，res至少(an + n - 1) / n个limb，返回res的长度
+	//精度倍增的牛顿迭代：先递归求出高半部分的根，再在完整长度上只做一步迭代，总代价是常数次完整长度的乘除法
+	uint32_t iroot(limb_t* res, const limb_t* a, uint32_t an, uint32_t n);
+	//先用模64和模2^32 - 1的剩余排除约99%的非平方数
+	bool isPerfectSquare(const limb_t* a, uint32_t an);
+	//是否存在y和k >= 2使a = y^k，odd_only时只考虑奇数k(用于负数)
+	bool isPerfectPower(const limb_t* a, uint32_t an, bool odd_only);
+}
@@ -0,0 +1,219 @@
+#include<stdexcept>
+#include<algorithm>
+#include<cstring>
+
+#include"src/Modulus.h"
+#include"src/Util.h"
+#include"src/Limbs.h"
+
+Modulus::Modulus(const BigInt& m) :_m{ m } {
+	if (m.isNaN() || m._size == 0 || !m._sign) throw std::domain_error("modulus must be positive");
+	_montgomery = m._limbs[0] & 1;
+	_n = _montgomery ? (m._size + 1) & ~1u : m._size;
+	_mod.assign(_n, 0);
+	std::copy(m._limbs, m._limbs + m._size, _mod.begin());
+	//2^(64n)
+	BigInt base(m._resource);
+	base.reserve(2 * _n + 1);
+	std::memset(base._limbs, 0, 2 * _n * sizeof(limb_t));
+	base._limbs[2 * _n] = 1;
+	base._size = 2 * _n + 1;
+	if (_montgomery) {
+		//牛顿迭代，每次正确的位数翻倍，奇数的逆模8就是它自己
+		uint64_t m0{ m._limbs[0] };
+		if (m._size > 1) m0 |= uint64_t(m._limbs[1]) << limbs::limb_bits;
+		uint64_t x{ m0 };
+		for (int i = 0; i < 5; ++i) x *= 2 - m0 * x;
+		_inv = 0 - x;
+		_r2.resize(_n);
+		load(_r2.data(), base);
+	}
+	else {
+		BigInt mu = base / m;
+		_mu.assign(mu._limbs, mu._limbs + mu._size);
+	}
+}
+
+namespace {
+	//每个线程复用的临时空间，只在一次运算内部使用
+	BigInt::limb_t* scratchBuffer(size_t n) {
+		thread_local std::vector<BigInt::limb_t> buffer;
+		if (buffer.size() < n) buffer.resize(n);
+		return buffer.data();
+	}
+}
+
+BigInt Modulus::reduce(const BigInt& x) const {
+	if (x.isNaN()) return BigInt();
+	if (x._sign && limbs::compare(x._limbs, x._size, _m._limbs, _m._size) < 0) return x;
+	BigInt r = x % _m;
+	if (!r._sign) r += _m;
+	return r;
+}
+
+Modulus::Residue Modulus::to_domain(const BigInt& x) const {
+	Residue ret;
+	to_domain(ret, x);
+	return ret;
+}
+
+void Modulus::to_domain(Residue& res, const BigInt& x) const {
+	if (x.isNaN()) throw std::domain_error("NaN has no residue");
+	res._limbs.resize(_n);
+	load(res._limbs.data(), x);
+	//x * R^2 / R = x * R
+	if (_montgomery) mulResidue(res._limbs.data(), res._limbs.data(), _r2.data(), scratchBuffer(scratchSize()));
+}
+
+BigInt Modulus::from_domain(const Residue& x) const {
+	if (!_montgomery) return value(x._limbs.data());
+	//x * R / R = x
+	limb_t* t = scratchBuffer(scratchSize());
+	std::copy(x._limbs.begin(), x._limbs.end(), t);
+	std::fill(t + _n, t + 2 * _n, 0);
+	limbs::redcMontgomery(t, t, _mod.data(), _n, _inv);
+	return value(t);
+}
+
+void Modulus::mul(Residue& res, const Residue& a, const Residue& b) const {
+	res._limbs.resize(_n);
+	mulResidue(res._limbs.data(), a._limbs.data(), b._limbs.data(), scratchBuffer(scratchSize()));
+}
+
+void Modulus::square(Residue& res, const Residue& a) const {
+	res._limbs.resize(_n);
+	squareResidue(res._limbs.data(), a._limbs.data(), scratchBuffer(scratchSize()));
+}
+
+BigInt Modulus::mul(const BigInt& a, const BigInt& b) const {
+	if (a.isNaN() || b.isNaN()) return BigInt();
+	limb_t* s = scratchBuffer(scratchSize() + 2 * size_t(_n));
+	limb_t* x = s + scratchSize(), * y = x + _n;
+	load(x, a);
+	load(y, b);
+	mulResidue(x, x, y, s);
+	//a * b / R再乘R^2 / R得到a * b
+	if (_montgomery) mulResidue(x, x, _r2.data(), s);
+	return value(x);
+}
+
+BigInt Modulus::square(const BigInt& a) const {
+	if (a.isNaN()) return BigInt();
+	limb_t* s = scratchBuffer(scratchSize() + _n);
+	limb_t* x = s + scratchSize();
+	load(x, a);
+	squareResidue(x, x, s);
+	if (_montgomery) mulResidue(x, x, _r2.data(), s);
+	return value(x);
+}
+
+BigInt Modulus::pow(const BigInt& base, const BigInt& exp) const {
+	if (base.isNaN() || exp.isNaN()) return BigInt();
+	//负指数先求逆元，不可逆时mod_inverse抛出std::domain_error
+	if (!exp._sign) return pow(util::mod_inverse(base, _m), -exp);
+	if (exp._size == 0) return reduce(BigInt(1));
+	uint32_t bits = exp._size * limbs::limb_bits - limbs::countLeadingZeros(exp._limbs[exp._size - 1]);
+	auto bit = [&](uint32_t i) { return (exp._limbs[i / limbs::limb_bits] >> (i % limbs::limb_bits)) & 1; };
+	//窗口越大预计算的奇数次幂越多，乘法越少，按指数长度取总次数最少的窗口
+	uint32_t k = bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : bits > 1 ? 2 : 1;
+
+	//table[i] = base^(2i + 1)，都在约简域中
+	std::vector<Residue> table(size_t(1) << (k - 1));
+	to_domain(table[0], base);
+	Residue sq;
+	square(sq, table[0]);
+	for (size_t i = 1; i < table.size(); ++i) mul(table[i], table[i - 1], sq);
+
+	Residue acc;
+	bool empty{ true };
+	for (int64_t i = int64_t(bits) - 1; i >= 0;) {
+		if (!bit(uint32_t(i))) {
+			square(acc, acc);
+			--i;
+			continue;
+		}
+		//以1结尾的最长窗口[j, i]
+		int64_t j = std::max<int64_t>(i - k + 1, 0);
+		while (!bit(uint32_t(j))) ++j;
+		uint32_t window{ 0 };
+		for (int64_t t = i; t >= j; --t) window = (window << 1) | bit(uint32_t(t));
+		if (empty) {
+			acc = table[window >> 1];
+			empty = false;
+		}
+		else {
+			for (int64_t t = i; t >= j; --t) square(acc, acc);
+			mul(acc, acc, table[window >> 1]);
+		}
+		i = j - 1;
+	}
+	return from_domain(acc);
+}
+
+void Modulus::load(limb_t* res, const BigInt& x) const {
+	if (x._sign && limbs::compare(x._limbs, x._size, _m._limbs, _m._size) < 0) {
+		std::copy(x._limbs, x._limbs + x._size, res);
+		std::fill(res + x._size, res + _n, 0);
+		return;
+	}
+	BigInt r = reduce(x);
+	std::copy(r._limbs, r._limbs + r._size, res);
+	std::fill(res + r._size, res + _n, 0);
+}
+
+BigInt Modulus::value(const limb_t* x) const {
+	BigInt ret(_m._resource);
+	ret.reserve(_n);
+	std::memcpy(ret._limbs, x, _n * sizeof(limb_t));
+	ret._size = _n;
+	ret.normalize();
+	return ret;
+}
+
+size_t Modulus::scratchSize() const {
+	//Montgomery约简需要平方的乘积，Barrett约简需要乘积以及q1 * mu、q3 * m和余数的空间
+	return _montgomery ? 2 * size_t(_n) : 7 * size_t(_n) + 6;
+}
+
+void Modulus::mulResidue(limb_t* res, const limb_t* a, const limb_t* b, limb_t* scratch) const {
+	if (_montgomery) {
+		limbs::mulMontgomery(res, a, b, _mod.data(), _n, _inv, scratch);
+	}
+	else {
+		limbs::mul(scratch, a, _n, b, _n);
+		barrettReduce(res, scratch, scratch + 2 * _n);
+	}
+}
+
+void Modulus::squareResidue(limb_t* res, const limb_t* a, limb_t* scratch) const {
+	if (_montgomery) {
+		limbs::sqrMontgomery(res, a, _mod.data(), _n, _inv, scratch);
+	}
+	else {
+		limbs::sqr(scratch, a, _n);
+		barrettReduce(res, scratch, scratch + 2 * _n);
+	}
+}
+
+void Modulus::barrettReduce(limb_t* res, const limb_t* t, limb_t* scratch) const {
+	//HAC 14.42，b = 2^32，k = n
+	uint32_t mus = static_cast<uint32_t>(_mu.size());
+	//q2 = floor(t / b^(n - 1)) * mu，q3 = floor(q2 / b^(n + 1))
+	limb_t* q2 = scratch;
+	limbs::mul(q2, t + _n - 1, _n + 1, _mu.data(), mus);
+	limb_t* q3 = q2 + _n + 1;
+	uint32_t q3n = limbs::normalizedSize(q3, mus);
+	//r = (t - q3 * m) mod b^(n + 1)
+	limb_t* r = q2 + _n + 1 + mus;
+	std::copy(t, t + _n + 1, r);
+	if (q3n > 0) {
+		limb_t* qm = r + _n + 1;
+		limbs::mul(qm, q3, q3n, _mod.data(), _n);
+		limbs::sub(r, r, _n + 1, qm, _n + 1);
+	}
+	//r < 3m
+	while (limbs::compare(r, limbs::normalizedSize(r, _n + 1), _mod.data(), _n) >= 0) {
+		limbs::sub(r, r, _n + 1, _mod.data(), _n);
+	}
+	std::copy(r, r + _n, res);
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include<src/BigInt_impl.h>
+#include<vector>
+
+//固定模数的上下文，构造时预计算约简常数
+//奇数模数使用Montgomery约简，偶数模数使用Barrett约简
+//结果都在[0, m)内，NaN参与运算时结果为NaN
+//反复运算时先用to_domain把操作数转换成Residue，在约简域中调用mul、square，最后用from_domain取出结果
+//这样每次运算只有一次约简，不做除法；临时空间按线程复用，模数短于karatsuba阈值时不分配内存
+class Modulus {
+	using limb_t = BigInt::limb_t;
+public:
+	//约简域中的剩余，n个limb，Montgomery约简时保存x * R mod m，R = 2^(32n)
+	//只能与创建它的Modulus一起使用
+	class Residue {
+	public:
+		Residue() = default;
+	private:
+		friend class Modulus;
+		std::vector<limb_t> _limbs;
+	};
+
+	//m必须为正，否则抛出std::domain_error
+	explicit Modulus(const BigInt& m);
+
+	const BigInt& value() const { return _m; }
+	//x mod m，负数也映射到[0, m)；只有x不在[0, m)内时才做一次除法
+	BigInt reduce(const BigInt& x) const;
+
+	//x不在[0, m)内时先reduce；x为NaN时抛出std::domain_error
+	Residue to_domain(const BigInt& x) const;
+	void to_domain(Residue& res, const BigInt& x) const;
+	BigInt from_domain(const Residue& x) const;
+	//res = a * b，a, b必须来自同一个Modulus，res可以与a, b相同，res已有的空间会被复用
+	void mul(Residue& res, const Residue& a, const Residue& b) const;
+	//res = a * a，交叉项只算一次，模数较长时比mul少做约四分之一的乘法
+	void square(Residue& res, const Residue& a) const;
+
+	//普通值之间的运算，每次都要转换进出约简域，Montgomery约简时比Residue上的运算多一次约简
+	BigInt mul(const BigInt& a, const BigInt& b) const;
+	BigInt square(const BigInt& a) const;
+	//滑动窗口求base^exp mod m，中间结果一直留在约简域中；exp < 0时先求逆元，base不可逆时抛出std::domain_error
+	BigInt pow(const BigInt& base, const BigInt& exp) const;
+private:
+	//reduce(x)补0到n个limb写入res
+	void load(limb_t* res, const BigInt& x) const;
+	BigInt value(const limb_t* x) const;
+	//res = a * b(Montgomery约简时为a * b / R)，res可以与a, b相同，scratch至少scratchSize()个limb
+	void mulResidue(limb_t* res, const limb_t* a, const limb_t* b, limb_t* scratch) const;
+	//res = a * a(Montgomery约简时为a * a / R)
+	void squareResidue(limb_t* res, const limb_t* a, limb_t* scratch) const;
+	size_t scratchSize() const;
+	void barrettReduce(limb_t* res, const limb_t* t, limb_t* scratch) const;
+
+	BigInt _m;
+	//剩余的limb个数，Montgomery约简时补齐到偶数
+	uint32_t _n;
+	bool _montgomery;
+	//补0到n个limb的模数
+	std::vector<limb_t> _mod;
+	//-m^(-1) mod 2^64
+	uint64_t _inv{ 0 };
+	//R^2 mod m，用于把普通的值转换到Montgomery域
+	std::vector<limb_t> _r2;
+	//floor(2^(64n) / m)
+	std::vector<limb_t> _mu;
+};
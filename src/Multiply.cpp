@@ -0,0 +1,705 @@
+#include<vector>
+#include<complex>
+#include<memory>
+#include<mutex>
+#include<cmath>
+#include<algorithm>
+#include<atomic>
+#include<chrono>
+#include<limits>
+
+#include"src/Limbs.h"
+
+namespace limbs {
+	//单位根表：rt[k + j] = e^(i*pi*j/k)，k为2的幂，较小的变换直接复用较大表的前缀
+	static std::shared_ptr<const std::vector<std::complex<double>>> fftRoots(uint32_t n) {
+		static std::mutex roots_mutex;
+		static std::shared_ptr<const std::vector<std::complex<double>>> roots;
+		std::lock_guard<std::mutex> lock(roots_mutex);
+		if (!roots || roots->size() < n) {
+			const double pi = 3.141592653589793238462643383279502884e+00;
+			auto table = std::make_shared<std::vector<std::complex<double>>>(std::max(n, 2u));
+			(*table)[1] = 1;
+			for (uint32_t k = 2; k < n; k <<= 1) {
+				for (uint32_t j = 0; j < k; ++j) {
+					(*table)[k + j] = std::polar(1.0, pi * j / k);
+				}
+			}
+			roots = table;
+		}
+		return roots;
+	}
+
+	static uint32_t reverseBits(uint32_t x) {
+		x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+		x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+		x = ((x >> 4) & 0x0f0f0f0fu) | ((x & 0x0f0f0f0fu) << 4);
+		x = ((x >> 8) & 0x00ff00ffu) | ((x & 0x00ff00ffu) << 8);
+		return (x >> 16) | (x << 16);
+	}
+
+	//并行的位逆序置换和蝶形合并，每一层的n / 2个蝶形均分给各线程，层与层之间同步
+	template<typename T, typename Butterfly>
+	static void transformParallel(std::vector<T>& ply, Butterfly butterfly) {
+		uint32_t n = static_cast<uint32_t>(ply.size());
+		int shift = limb_bits - (limb_bits - 1 - countLeadingZeros(n));
+		parallelRange(n, [&](uint32_t first, uint32_t last) {
+			for (uint32_t i = first; i < last; ++i) {
+				//每一对只由较小下标所在的线程交换
+				uint32_t j = reverseBits(i) >> shift;
+				if (i < j) std::swap(ply[i], ply[j]);
+			}
+		});
+		for (uint32_t k = 1; k < n; k <<= 1) {
+			parallelRange(n / 2, [&](uint32_t first, uint32_t last) {
+				for (uint32_t b = first; b < last; ++b) {
+					uint32_t j = b & (k - 1);
+					butterfly(2 * (b - j) + j, k, j);
+				}
+			});
+		}
+	}
+
+	//迭代的原地fft，先做位逆序置换再自底向上蝶形合并
+	static void fft(std::vector<std::complex<double>>& ply, const std::vector<std::complex<double>>& rt, bool parallel) {
+		auto butterfly = [&ply, &rt](uint32_t i, uint32_t k, uint32_t j) {
+			std::complex<double> z = rt[j + k] * ply[i + k];
+			ply[i + k] = ply[i] - z;
+			ply[i] += z;
+		};
+		if (parallel) {
+			transformParallel(ply, butterfly);
+			return;
+		}
+		uint32_t n = static_cast<uint32_t>(ply.size());
+		for (uint32_t i = 1, j = 0; i < n; ++i) {
+			uint32_t bit = n >> 1;
+			for (; j & bit; bit >>= 1) j ^= bit;
+			j ^= bit;
+			if (i < j) std::swap(ply[i], ply[j]);
+		}
+		for (uint32_t k = 1; k < n; k <<= 1) {
+			for (uint32_t i = 0; i < n; i += 2 * k) {
+				for (uint32_t j = 0; j < k; ++j) butterfly(i + j, k, j);
+			}
+		}
+	}
+
+	//fft o(nlogn)
+	void mulFFT(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		//每个limb拆成两个16位的系数，a放在实部，b放在虚部，只做一次正变换
+		uint32_t pow2sz{ 2 };
+		while (pow2sz < 2 * (an + bn)) pow2sz <<= 1;
+		auto rt = fftRoots(pow2sz);
+		bool parallel = useParallel(std::min(an, bn));
+
+		std::vector<std::complex<double>> ply(pow2sz);
+		for (uint32_t i = 0; i < an; ++i) {
+			ply[2 * i].real(a[i] & 0xffff);
+			ply[2 * i + 1].real(a[i] >> 16);
+		}
+		for (uint32_t i = 0; i < bn; ++i) {
+			ply[2 * i].imag(b[i] & 0xffff);
+			ply[2 * i + 1].imag(b[i] >> 16);
+		}
+		fft(ply, *rt, parallel);
+		//P = A + iB, P^2 = A^2 - B^2 + 2iAB，利用共轭对称性从P^2中分离出AB
+		//下标i和n - i成对处理，只遍历i <= n / 2
+		auto separate = [&ply, pow2sz](uint32_t first, uint32_t last) {
+			for (uint32_t i = first; i < last; ++i) {
+				uint32_t j = (pow2sz - i) & (pow2sz - 1);
+				std::complex<double> xi = ply[i] * ply[i], xj = ply[j] * ply[j];
+				ply[i] = xj - std::conj(xi);
+				ply[j] = xi - std::conj(xj);
+			}
+		};
+		if (parallel) parallelRange(pow2sz / 2 + 1, separate);
+		else separate(0, pow2sz / 2 + 1);
+		fft(ply, *rt, parallel);
+		//进位
+		double scale = 4.0 * pow2sz;
+		dlimb_t carry{ 0 };
+		for (uint32_t i = 0; i < an + bn; ++i) {
+			carry += static_cast<dlimb_t>(std::llround(ply[2 * i].imag() / scale));
+			limb_t low = static_cast<limb_t>(carry & 0xffff);
+			carry >>= 16;
+			carry += static_cast<dlimb_t>(std::llround(ply[2 * i + 1].imag() / scale));
+			limb_t high = static_cast<limb_t>(carry & 0xffff);
+			carry >>= 16;
+			res[i] = low | (high << 16);
+		}
+	}
+
+	//平方只需要一次长度减半的正变换: 相邻两个16位系数组成一个复数，变换后拆出实序列的频谱
+	//X[k] = E[k] + w^k * O[k], X[k + m] = E[k] - w^k * O[k]，E, O是偶数项和奇数项的频谱，w = e^(i*pi/m)
+	void sqrFFT(limb_t* res, const limb_t* a, uint32_t an) {
+		uint32_t m{ 2 };
+		while (m < 2 * an) m <<= 1;
+		auto rt = fftRoots(2 * m);
+		bool parallel = useParallel(an);
+
+		std::vector<std::complex<double>> ply(m);
+		for (uint32_t i = 0; i < an; ++i) ply[i] = std::complex<double>(a[i] & 0xffff, a[i] >> 16);
+		fft(ply, *rt, parallel);
+		//平方后按相反的方式合并回长度m的频谱，取共轭使第二次正变换等价于逆变换
+		auto square = [&rt, m](std::complex<double> zk, std::complex<double> zj, uint32_t k) {
+			std::complex<double> e = (zk + std::conj(zj)) * 0.5;
+			std::complex<double> o = (zk - std::conj(zj)) * std::complex<double>(0, -0.5);
+			std::complex<double> w = (*rt)[m + k];
+			std::complex<double> low = e + w * o, high = e - w * o;
+			low *= low;
+			high *= high;
+			std::complex<double> ye = (low + high) * 0.5, yo = (low - high) * 0.5 * std::conj(w);
+			return std::conj(ye + std::complex<double>(0, 1) * yo);
+		};
+		auto combine = [&](uint32_t first, uint32_t last) {
+			for (uint32_t k = first; k < last; ++k) {
+				uint32_t j = (m - k) & (m - 1);
+				std::complex<double> zk = ply[k], zj = ply[j];
+				ply[k] = square(zk, zj, k);
+				ply[j] = square(zj, zk, j);
+			}
+		};
+		if (parallel) parallelRange(m / 2 + 1, combine);
+		else combine(0, m / 2 + 1);
+		fft(ply, *rt, parallel);
+		//实部是偶数项，虚部取反是奇数项
+		double scale = m;
+		dlimb_t carry{ 0 };
+		for (uint32_t i = 0; i < 2 * an; ++i) {
+			carry += static_cast<dlimb_t>(std::llround(ply[i].real() / scale));
+			limb_t low = static_cast<limb_t>(carry & 0xffff);
+			carry >>= 16;
+			carry += static_cast<dlimb_t>(std::llround(-ply[i].imag() / scale));
+			limb_t high = static_cast<limb_t>(carry & 0xffff);
+			carry >>= 16;
+			res[i] = low | (high << 16);
+		}
+	}
+
+	//ntt使用的三个素数，均为c * 2^k + 1的形式，最长支持2^25的变换
+	struct NttPrime {
+		limb_t mod;
+		limb_t root;
+	};
+	static const NttPrime ntt_primes[3] = { { 2013265921u, 31u }, { 469762049u, 3u }, { 167772161u, 3u } };
+	constexpr uint32_t ntt_max_length = 1u << 25;
+	//三个素数之积约为2^87，较短一方不超过2^23个limb时卷积系数不会溢出
+	constexpr uint32_t ntt_max_operand = 1u << 23;
+
+	static limb_t powMod(limb_t base, uint64_t exp, limb_t mod) {
+		dlimb_t ret{ 1 }, b{ base % mod };
+		while (exp > 0) {
+			if (exp & 1) ret = ret * b % mod;
+			b = b * b % mod;
+			exp >>= 1;
+		}
+		return static_cast<limb_t>(ret);
+	}
+
+	//w * x mod p，shoup = floor(w * 2^32 / p)预先算好，省去64位除法
+	static inline limb_t mulShoup(limb_t x, limb_t w, limb_t shoup, limb_t mod) {
+		limb_t q = static_cast<limb_t>((dlimb_t(x) * shoup) >> limb_bits);
+		limb_t r = x * w - q * mod;
+		return r >= mod ? r - mod : r;
+	}
+
+	struct NttRoots {
+		std::vector<limb_t> rt;
+		std::vector<limb_t> shoup;
+	};
+
+	//与fftRoots相同的布局，每个素数一张表
+	static std::shared_ptr<const NttRoots> nttRoots(int prime, uint32_t n) {
+		static std::mutex roots_mutex;
+		static std::shared_ptr<const NttRoots> roots[3];
+		std::lock_guard<std::mutex> lock(roots_mutex);
+		if (!roots[prime] || roots[prime]->rt.size() < n) {
+			limb_t mod = ntt_primes[prime].mod;
+			auto table = std::make_shared<NttRoots>();
+			table->rt.resize(std::max(n, 2u));
+			table->shoup.resize(std::max(n, 2u));
+			table->rt[1] = 1;
+			for (uint32_t k = 2; k < n; k <<= 1) {
+				limb_t wk = powMod(ntt_primes[prime].root, (mod - 1) / (2 * k), mod);
+				dlimb_t w{ 1 };
+				for (uint32_t j = 0; j < k; ++j, w = w * wk % mod) {
+					table->rt[k + j] = static_cast<limb_t>(w);
+				}
+			}
+			for (uint32_t i = 1; i < table->rt.size(); ++i) {
+				table->shoup[i] = static_cast<limb_t>((dlimb_t(table->rt[i]) << limb_bits) / mod);
+			}
+			roots[prime] = table;
+		}
+		return roots[prime];
+	}
+
+	static void ntt(std::vector<limb_t>& ply, const NttRoots& roots, limb_t mod, bool parallel) {
+		if (parallel) {
+			transformParallel(ply, [&ply, &roots, mod](uint32_t i, uint32_t k, uint32_t j) {
+				limb_t z = mulShoup(ply[i + k], roots.rt[j + k], roots.shoup[j + k], mod);
+				limb_t x = ply[i];
+				ply[i + k] = x >= z ? x - z : x + mod - z;
+				ply[i] = x + z >= mod ? x + z - mod : x + z;
+			});
+			return;
+		}
+		uint32_t n = static_cast<uint32_t>(ply.size());
+		for (uint32_t i = 1, j = 0; i < n; ++i) {
+			uint32_t bit = n >> 1;
+			for (; j & bit; bit >>= 1) j ^= bit;
+			j ^= bit;
+			if (i < j) std::swap(ply[i], ply[j]);
+		}
+		for (uint32_t k = 1; k < n; k <<= 1) {
+			for (uint32_t i = 0; i < n; i += 2 * k) {
+				for (uint32_t j = 0; j < k; ++j) {
+					limb_t z = mulShoup(ply[i + j + k], roots.rt[j + k], roots.shoup[j + k], mod);
+					limb_t x = ply[i + j];
+					ply[i + j + k] = x >= z ? x - z : x + mod - z;
+					ply[i + j] = x + z >= mod ? x + z - mod : x + z;
+				}
+			}
+		}
+	}
+
+	//在单个素数下计算a * b的循环卷积，结果写回ply
+	static void convolution(std::vector<limb_t>& ply, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn, uint32_t pow2sz, int prime, bool parallel) {
+		limb_t mod = ntt_primes[prime].mod;
+		auto roots = nttRoots(prime, pow2sz);
+		//a, b是同一段时是平方，只需要一次正变换
+		bool square = a == b && an == bn;
+		std::vector<limb_t> other(square ? 0 : pow2sz, 0);
+		ply.assign(pow2sz, 0);
+		//逐元素的循环在并行模式下均分给各线程
+		auto forRange = [parallel](uint32_t n, const std::function<void(uint32_t, uint32_t)>& task) {
+			if (parallel) parallelRange(n, task);
+			else task(0, n);
+		};
+		forRange(std::max(an, bn), [&](uint32_t first, uint32_t last) {
+			for (uint32_t i = first; i < std::min(last, an); ++i) ply[i] = a[i] % mod;
+			if (!square) for (uint32_t i = first; i < std::min(last, bn); ++i) other[i] = b[i] % mod;
+		});
+		ntt(ply, *roots, mod, parallel);
+		if (!square) ntt(other, *roots, mod, parallel);
+		const std::vector<limb_t>& factor = square ? ply : other;
+		forRange(pow2sz, [&](uint32_t first, uint32_t last) {
+			for (uint32_t i = first; i < last; ++i) ply[i] = static_cast<limb_t>(dlimb_t(ply[i]) * factor[i] % mod);
+		});
+		//正变换后把下标1..n-1反转即为逆变换，再乘以n^-1
+		ntt(ply, *roots, mod, parallel);
+		std::reverse(ply.begin() + 1, ply.end());
+		limb_t inv_n = powMod(pow2sz, mod - 2, mod);
+		limb_t inv_n_shoup = static_cast<limb_t>((dlimb_t(inv_n) << limb_bits) / mod);
+		forRange(pow2sz, [&](uint32_t first, uint32_t last) {
+			for (uint32_t i = first; i < last; ++i) ply[i] = mulShoup(ply[i], inv_n, inv_n_shoup, mod);
+		});
+	}
+
+	//Garner算法还原res[first, last)的系数: c = x + p0 * p1 * t, x < p0 * p1
+	//不带入低位的进位，返回向last进位的64位值
+	static dlimb_t garner(limb_t* res, const std::vector<limb_t>* r, uint32_t first, uint32_t last) {
+		const limb_t p0 = ntt_primes[0].mod, p1 = ntt_primes[1].mod, p2 = ntt_primes[2].mod;
+		const dlimb_t p01 = dlimb_t(p0) * p1;
+		const limb_t inv_p0 = powMod(p0, p1 - 2, p1);
+		const limb_t inv_p01 = powMod(static_cast<limb_t>(p01 % p2), p2 - 2, p2);
+		const dlimb_t mask{ 0xffffffffu };
+		dlimb_t carry{ 0 };
+		for (uint32_t i = first; i < last; ++i) {
+			dlimb_t t1 = (dlimb_t(r[1][i]) + p1 - r[0][i] % p1) % p1 * inv_p0 % p1;
+			dlimb_t x = r[0][i] + p0 * t1;
+			dlimb_t t2 = (dlimb_t(r[2][i]) + p2 - x % p2) % p2 * inv_p01 % p2;
+			dlimb_t low = (p01 & mask) * t2, high = (p01 >> limb_bits) * t2;
+			//c + carry按96位相加，取出最低的limb
+			dlimb_t sum = (x & mask) + (low & mask) + (carry & mask);
+			res[i] = static_cast<limb_t>(sum);
+			sum >>= limb_bits;
+			sum += (x >> limb_bits) + (low >> limb_bits) + (high & mask) + (carry >> limb_bits);
+			dlimb_t mid = sum & mask;
+			sum >>= limb_bits;
+			sum += high >> limb_bits;
+			carry = (sum << limb_bits) | mid;
+		}
+		return carry;
+	}
+
+	//单次ntt，要求an + bn <= ntt_max_length且min(an, bn) <= ntt_max_operand
+	static void mulNTTBlock(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		uint32_t pow2sz{ 2 };
+		while (pow2sz < an + bn) pow2sz <<= 1;
+		std::vector<limb_t> r[3];
+		if (!useParallel(std::min(an, bn))) {
+			for (int prime = 0; prime < 3; ++prime) convolution(r[prime], a, an, b, bn, pow2sz, prime, false);
+			garner(res, r, 0, an + bn);
+			return;
+		}
+		//三个素数下的卷积互相独立，每个卷积内部的变换也并行
+		parallelFor(3, [&](uint32_t prime) { convolution(r[prime], a, an, b, bn, pow2sz, static_cast<int>(prime), true); });
+		//各段先独立还原，再依次把段间的进位加到下一段开头
+		uint32_t n = an + bn, parts = parallelThreads();
+		std::vector<dlimb_t> carries(parts);
+		parallelFor(parts, [&](uint32_t p) {
+			carries[p] = garner(res, r, static_cast<uint32_t>(uint64_t(n) * p / parts), static_cast<uint32_t>(uint64_t(n) * (p + 1) / parts));
+		});
+		for (uint32_t p = 0; p + 1 < parts; ++p) {
+			uint32_t pos = static_cast<uint32_t>(uint64_t(n) * (p + 1) / parts);
+			dlimb_t carry = carries[p];
+			for (uint32_t i = pos; i < n && carry; ++i) {
+				carry += res[i];
+				res[i] = static_cast<limb_t>(carry);
+				carry >>= limb_bits;
+			}
+		}
+	}
+
+	void mulNTT(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		//超出单次ntt的长度时分块相乘再累加
+		const uint32_t block = ntt_max_operand;
+		if (an + bn <= ntt_max_length && std::min(an, bn) <= block) {
+			mulNTTBlock(res, a, an, b, bn);
+			return;
+		}
+		std::fill(res, res + an + bn, 0);
+		std::vector<limb_t> part;
+		for (uint32_t i = 0; i < an; i += block) {
+			uint32_t ai = std::min(block, an - i);
+			for (uint32_t j = 0; j < bn; j += block) {
+				uint32_t bj = std::min(block, bn - j);
+				part.resize(ai + bj);
+				mulNTTBlock(part.data(), a + i, ai, b + j, bj);
+				add(res + i + j, res + i + j, an + bn - i - j, part.data(), ai + bj);
+			}
+		}
+	}
+
+	//默认值取自x64上tuneMulThresholds的实测结果
+	static std::atomic<uint32_t> karatsuba_threshold{ 32 };
+	static std::atomic<uint32_t> toom3_threshold{ 384 };
+	static std::atomic<uint32_t> fft_threshold{ 1792 };
+
+	MulThresholds mulThresholds() {
+		return MulThresholds{ karatsuba_threshold.load(std::memory_order_relaxed),
+			toom3_threshold.load(std::memory_order_relaxed), fft_threshold.load(std::memory_order_relaxed) };
+	}
+
+	void setMulThresholds(const MulThresholds& thresholds) {
+		//(a0 + a1)(b0 + b1)有k + 1个limb，n < 4时不比原问题小，会无限递归
+		karatsuba_threshold.store(std::max(thresholds.karatsuba, 4u), std::memory_order_relaxed);
+		toom3_threshold.store(std::max(thresholds.toom3, 3u), std::memory_order_relaxed);
+		fft_threshold.store(std::max(thresholds.fft, 2u), std::memory_order_relaxed);
+	}
+
+	void mulBasecase(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		if (an == 0 || bn == 0) {
+			std::fill(res, res + an + bn, 0);
+			return;
+		}
+		res[an] = mulBySingle(res, a, an, b[0]);
+		for (uint32_t j = 1; j < bn; ++j) {
+			res[an + j] = addMulBySingle(res + j, a, an, b[j]);
+		}
+	}
+
+	//交叉项a[i] * a[j](i < j)只算一次再乘2，最后加上对角线上的a[i]^2，乘法次数约为mulBasecase的一半
+	void sqrBasecase(limb_t* res, const limb_t* a, uint32_t an) {
+		if (an == 0) return;
+		std::fill(res, res + 2 * an, 0);
+		for (uint32_t i = 0; i + 1 < an; ++i) {
+			res[an + i] = addMulBySingle(res + 2 * i + 1, a + i + 1, an - i - 1, a[i]);
+		}
+		lshift(res, res, 2 * an, 1);
+		dlimb_t carry{ 0 };
+		for (uint32_t i = 0; i < an; ++i) {
+			dlimb_t sq = dlimb_t(a[i]) * a[i];
+			carry += dlimb_t(res[2 * i]) + limb_t(sq);
+			res[2 * i] = limb_t(carry);
+			carry >>= limb_bits;
+			carry += dlimb_t(res[2 * i + 1]) + (sq >> limb_bits);
+			res[2 * i + 1] = limb_t(carry);
+			carry >>= limb_bits;
+		}
+	}
+
+	//把c加到res[offset, n)上，c必须不会让res溢出
+	static void addAt(limb_t* res, uint32_t n, uint32_t offset, const limb_t* c, uint32_t cn) {
+		cn = normalizedSize(c, cn);
+		if (cn > 0) add(res + offset, res + offset, n - offset, c, cn);
+	}
+
+	//a = a1 * B^k + a0, b = b1 * B^k + b0
+	//a * b = z2 * B^2k + ((a0 + a1)(b0 + b1) - z0 - z2) * B^k + z0
+	void mulKaratsuba(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		uint32_t k = (std::max(an, bn) + 1) / 2;
+		uint32_t a0n = std::min(k, an), a1n = an - a0n;
+		uint32_t b0n = std::min(k, bn), b1n = bn - b0n;
+		std::fill(res, res + an + bn, 0);
+		std::vector<limb_t> sa(k + 1, 0), sb(k + 1, 0), z1(2 * k + 2, 0);
+		//平方时三个子乘积也都是平方
+		bool square = a == b && an == bn;
+		sa[k] = add(sa.data(), a, a0n, a + k, a1n);
+		if (!square) sb[k] = add(sb.data(), b, b0n, b + k, b1n);
+		const limb_t* sbp = square ? sa.data() : sb.data();
+		//z0和z2写入res中不重叠的两段，三个子乘积可以同时计算
+		auto product = [&](uint32_t i) {
+			if (i == 0) mul(res, a, a0n, b, b0n);
+			else if (i == 1) mul(res + 2 * k, a + k, a1n, b + k, b1n);
+			else mul(z1.data(), sa.data(), k + 1, sbp, k + 1);
+		};
+		if (useParallel(k)) parallelFor(3, product);
+		else for (uint32_t i = 0; i < 3; ++i) product(i);
+		sub(z1.data(), z1.data(), 2 * k + 2, res, a0n + b0n);
+		sub(z1.data(), z1.data(), 2 * k + 2, res + 2 * k, a1n + b1n);
+		addAt(res, an + bn, k, z1.data(), 2 * k + 2);
+	}
+
+	//toom-3插值时需要带符号的中间量
+	struct SignedLimbs {
+		std::vector<limb_t> mag;
+		bool neg{ false };
+	};
+
+	static SignedLimbs toSigned(const limb_t* a, uint32_t n) {
+		SignedLimbs ret;
+		ret.mag.assign(a, a + normalizedSize(a, n));
+		return ret;
+	}
+
+	//x = x + y或x - y
+	static void addSigned(SignedLimbs& x, const SignedLimbs& y, bool subtract) {
+		bool y_neg = y.neg != subtract;
+		uint32_t xn = static_cast<uint32_t>(x.mag.size()), yn = static_cast<uint32_t>(y.mag.size());
+		if (x.neg == y_neg) {
+			x.mag.resize(std::max(xn, yn) + 1, 0);
+			limb_t carry = xn >= yn ? add(x.mag.data(), x.mag.data(), xn, y.mag.data(), yn)
+				: add(x.mag.data(), y.mag.data(), yn, x.mag.data(), xn);
+			x.mag[std::max(xn, yn)] = carry;
+		}
+		else if (compare(x.mag.data(), xn, y.mag.data(), yn) >= 0) {
+			sub(x.mag.data(), x.mag.data(), xn, y.mag.data(), yn);
+		}
+		else {
+			x.mag.resize(yn, 0);
+			sub(x.mag.data(), y.mag.data(), yn, x.mag.data(), xn);
+			x.neg = y_neg;
+		}
+		x.mag.resize(normalizedSize(x.mag.data(), static_cast<uint32_t>(x.mag.size())));
+		if (x.mag.empty()) x.neg = false;
+	}
+
+	static void mulSingleSigned(SignedLimbs& x, limb_t m) {
+		x.mag.push_back(0);
+		x.mag.back() = mulBySingle(x.mag.data(), x.mag.data(), static_cast<uint32_t>(x.mag.size() - 1), m);
+		x.mag.resize(normalizedSize(x.mag.data(), static_cast<uint32_t>(x.mag.size())));
+	}
+
+	//整除，调用方保证没有余数
+	static void divExactSigned(SignedLimbs& x, limb_t d) {
+		divBySingle(x.mag.data(), x.mag.data(), static_cast<uint32_t>(x.mag.size()), d);
+		x.mag.resize(normalizedSize(x.mag.data(), static_cast<uint32_t>(x.mag.size())));
+		if (x.mag.empty()) x.neg = false;
+	}
+
+	static SignedLimbs mulSigned(const SignedLimbs& x, const SignedLimbs& y) {
+		SignedLimbs ret;
+		uint32_t xn = static_cast<uint32_t>(x.mag.size()), yn = static_cast<uint32_t>(y.mag.size());
+		ret.mag.resize(xn + yn);
+		mul(ret.mag.data(), x.mag.data(), xn, y.mag.data(), yn);
+		ret.mag.resize(normalizedSize(ret.mag.data(), xn + yn));
+		ret.neg = !ret.mag.empty() && x.neg != y.neg;
+		return ret;
+	}
+
+	//在0, 1, -1, -2, inf五个点求值后插值(Bodrato的插值序列)
+	void mulToom3(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		uint32_t k = (std::max(an, bn) + 2) / 3;
+		auto split = [k](const limb_t* p, uint32_t n, SignedLimbs parts[3]) {
+			for (uint32_t i = 0; i < 3; ++i) {
+				uint32_t first = std::min(i * k, n), last = std::min(first + k, n);
+				parts[i] = toSigned(p + first, last - first);
+			}
+		};
+		auto evaluate = [](const SignedLimbs parts[3], SignedLimbs points[3]) {
+			//points = { p(1), p(-1), p(-2) }
+			SignedLimbs p0 = parts[0];
+			addSigned(p0, parts[2], false);
+			points[0] = p0;
+			addSigned(points[0], parts[1], false);
+			points[1] = p0;
+			addSigned(points[1], parts[1], true);
+			points[2] = points[1];
+			addSigned(points[2], parts[2], false);
+			mulSingleSigned(points[2], 2);
+			addSigned(points[2], parts[0], true);
+		};
+		SignedLimbs ap[3], bp[3], av[3], bv[3];
+		split(a, an, ap);
+		evaluate(ap, av);
+		//平方时b的各部分直接引用a的，五个乘积都是平方
+		bool square = a == b && an == bn;
+		if (!square) {
+			split(b, bn, bp);
+			evaluate(bp, bv);
+		}
+		const SignedLimbs* bps = square ? ap : bp;
+		const SignedLimbs* bvs = square ? av : bv;
+
+		//五个点上的乘积互相独立
+		SignedLimbs r0, r1, rm1, rm2, rinf;
+		auto product = [&](uint32_t i) {
+			switch (i) {
+			case 0: r0 = mulSigned(ap[0], bps[0]); break;
+			case 1: r1 = mulSigned(av[0], bvs[0]); break;
+			case 2: rm1 = mulSigned(av[1], bvs[1]); break;
+			case 3: rm2 = mulSigned(av[2], bvs[2]); break;
+			default: rinf = mulSigned(ap[2], bps[2]); break;
+			}
+		};
+		if (useParallel(k)) parallelFor(5, product);
+		else for (uint32_t i = 0; i < 5; ++i) product(i);
+
+		SignedLimbs t3 = rm2;
+		addSigned(t3, r1, true);
+		divExactSigned(t3, 3);
+		SignedLimbs t1 = r1;
+		addSigned(t1, rm1, true);
+		divExactSigned(t1, 2);
+		SignedLimbs t2 = rm1;
+		addSigned(t2, r0, true);
+		SignedLimbs tmp = t2;
+		addSigned(tmp, t3, true);
+		divExactSigned(tmp, 2);
+		addSigned(tmp, rinf, false);
+		addSigned(tmp, rinf, false);
+		t3 = tmp;
+		addSigned(t2, t1, false);
+		addSigned(t2, rinf, true);
+		addSigned(t1, t3, true);
+
+		//插值出的系数都是非负的
+		std::fill(res, res + an + bn, 0);
+		const SignedLimbs* coefs[5] = { &r0, &t1, &t2, &t3, &rinf };
+		for (uint32_t i = 0; i < 5; ++i) {
+			addAt(res, an + bn, i * k, coefs[i]->mag.data(), static_cast<uint32_t>(coefs[i]->mag.size()));
+		}
+	}
+
+	void sqr(limb_t* res, const limb_t* a, uint32_t an) {
+		MulThresholds thresholds = mulThresholds();
+		//很短时对称性省下的乘法抵不上额外的移位和对角线遍历
+		if (an < 8) {
+			mulBasecase(res, a, an, a, an);
+		}
+		//sqrBasecase的乘法次数减半，与karatsuba的交叉点约在乘法的两倍处
+		else if (an < 2 * thresholds.karatsuba) {
+			sqrBasecase(res, a, an);
+		}
+		else if (an >= thresholds.fft) {
+			if (2 * an <= ntt_threshold) sqrFFT(res, a, an);
+			else mulNTT(res, a, an, a, an);
+		}
+		else if (an >= thresholds.toom3) {
+			mulToom3(res, a, an, a, an);
+		}
+		else {
+			mulKaratsuba(res, a, an, a, an);
+		}
+	}
+
+	void mul(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+		if (a == b && an == bn) {
+			sqr(res, a, an);
+			return;
+		}
+		if (an < bn) {
+			std::swap(a, b);
+			std::swap(an, bn);
+		}
+		MulThresholds thresholds = mulThresholds();
+		if (bn < thresholds.karatsuba) {
+			mulBasecase(res, a, an, b, bn);
+		}
+		else if (an > 2 * bn) {
+			//极不平衡时把长的一方切成bn大小的块，每块与b做平衡的乘法
+			std::fill(res, res + an + bn, 0);
+			std::vector<limb_t> part(2 * bn);
+			for (uint32_t i = 0; i < an; i += bn) {
+				uint32_t ai = std::min(bn, an - i);
+				mul(part.data(), a + i, ai, b, bn);
+				addAt(res, an + bn, i, part.data(), ai + bn);
+			}
+		}
+		else if (bn >= thresholds.fft) {
+			if (an + bn <= ntt_threshold) mulFFT(res, a, an, b, bn);
+			else mulNTT(res, a, an, b, bn);
+		}
+		else if (bn >= thresholds.toom3) {
+			mulToom3(res, a, an, b, bn);
+		}
+		else {
+			mulKaratsuba(res, a, an, b, bn);
+		}
+	}
+
+	//单次调用f的平均耗时(纳秒)，重复到足够长以降低计时误差，取三次中的最小值
+	template<typename F>
+	static double measure(F&& f) {
+		double best = std::numeric_limits<double>::max();
+		for (int round = 0; round < 3; ++round) {
+			uint32_t reps{ 1 };
+			while (true) {
+				auto start = std::chrono::steady_clock::now();
+				for (uint32_t i = 0; i < reps; ++i) f();
+				double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+				if (elapsed > 2e5 || reps >= (1u << 20)) {
+					best = std::min(best, elapsed / reps);
+					break;
+				}
+				reps *= 2;
+			}
+		}
+		return best;
+	}
+
+	//找到第一个连续两次fast比slow快的规模
+	template<typename Slow, typename Fast>
+	static uint32_t crossover(uint32_t first, uint32_t last, Slow&& slow, Fast&& fast) {
+		bool won{ false };
+		uint32_t n = first;
+		for (; n < last; n += std::max(n / 8, 1u)) {
+			if (measure([&] { fast(n); }) < measure([&] { slow(n); })) {
+				if (won) return n;
+				won = true;
+			}
+			else won = false;
+		}
+		return last;
+	}
+
+	MulThresholds tuneMulThresholds() {
+		const uint32_t never = std::numeric_limits<uint32_t>::max();
+		const uint32_t max_n = 16384;
+		std::vector<limb_t> a(max_n), b(max_n), res(2 * max_n);
+		uint64_t seed{ 0x9e3779b97f4a7c15ull };
+		for (uint32_t i = 0; i < max_n; ++i) {
+			seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+			a[i] = static_cast<limb_t>(seed >> 32);
+			b[i] = static_cast<limb_t>(seed);
+		}
+		MulThresholds tuned{ never, never, never };
+		setMulThresholds(tuned);
+		tuned.karatsuba = crossover(8, 256,
+			[&](uint32_t n) { mulBasecase(res.data(), a.data(), n, b.data(), n); },
+			[&](uint32_t n) { mulKaratsuba(res.data(), a.data(), n, b.data(), n); });
+		setMulThresholds(tuned);
+		tuned.toom3 = crossover(std::max(tuned.karatsuba * 2, 24u), 2048,
+			[&](uint32_t n) { mulKaratsuba(res.data(), a.data(), n, b.data(), n); },
+			[&](uint32_t n) { mulToom3(res.data(), a.data(), n, b.data(), n); });
+		setMulThresholds(tuned);
+		tuned.fft = crossover(std::max(tuned.karatsuba, 32u), max_n,
+			[&](uint32_t n) { mul(res.data(), a.data(), n, b.data(), n); },
+			[&](uint32_t n) { mulFFT(res.data(), a.data(), n, b.data(), n); });
+		setMulThresholds(tuned);
+		return mulThresholds();
+	}
+}
@@ -0,0 +1,132 @@
+#include<vector>
+#include<deque>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<functional>
+#include<atomic>
+#include<memory>
+#include<algorithm>
+
+#include"src/Limbs.h"
+
+namespace limbs {
+	//固定数量的工作线程，从共享队列中取任务
+	class ThreadPool {
+	public:
+		~ThreadPool() {
+			resize(0);
+		}
+
+		void resize(uint32_t workers) {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stop = true;
+			}
+			_cv.notify_all();
+			for (auto& t : _workers) t.join();
+			_workers.clear();
+			_stop = false;
+			for (uint32_t i = 0; i < workers; ++i) {
+				_workers.emplace_back([this] { run(); });
+			}
+		}
+
+		void push(std::function<void()> job) {
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_jobs.push_back(std::move(job));
+			}
+			_cv.notify_one();
+		}
+	private:
+		void run() {
+			for (;;) {
+				std::function<void()> job;
+				{
+					std::unique_lock<std::mutex> lock(_mutex);
+					_cv.wait(lock, [this] { return _stop || !_jobs.empty(); });
+					if (_stop && _jobs.empty()) return;
+					job = std::move(_jobs.front());
+					_jobs.pop_front();
+				}
+				job();
+			}
+		}
+
+		std::vector<std::thread> _workers;
+		std::deque<std::function<void()>> _jobs;
+		std::mutex _mutex;
+		std::condition_variable _cv;
+		bool _stop{ false };
+	};
+
+	static ThreadPool& threadPool() {
+		static ThreadPool pool;
+		return pool;
+	}
+
+	//默认串行，需要显式打开
+	static std::atomic<uint32_t> parallel_threads{ 1 };
+	static std::atomic<uint32_t> parallel_threshold{ 1024 };
+	static std::mutex config_mutex;
+
+	ParallelConfig parallelConfig() {
+		return ParallelConfig{ parallel_threads.load(std::memory_order_relaxed), parallel_threshold.load(std::memory_order_relaxed) };
+	}
+
+	void setParallelConfig(const ParallelConfig& config) {
+		std::lock_guard<std::mutex> lock(config_mutex);
+		uint32_t threads = std::max(config.threads, 1u);
+		if (threads != parallel_threads.load(std::memory_order_relaxed)) {
+			//调用线程自己也参与计算，只需要threads - 1个工作线程
+			threadPool().resize(threads - 1);
+			parallel_threads.store(threads, std::memory_order_relaxed);
+		}
+		parallel_threshold.store(std::max(config.threshold, 1u), std::memory_order_relaxed);
+	}
+
+	bool useParallel(uint32_t n) {
+		return parallel_threads.load(std::memory_order_relaxed) > 1 && n >= parallel_threshold.load(std::memory_order_relaxed);
+	}
+
+	uint32_t parallelThreads() {
+		return parallel_threads.load(std::memory_order_relaxed);
+	}
+
+	void parallelRange(uint32_t n, const std::function<void(uint32_t, uint32_t)>& task) {
+		uint32_t parts = std::min(parallel_threads.load(std::memory_order_relaxed), std::max(n, 1u));
+		parallelFor(parts, [&](uint32_t p) {
+			task(static_cast<uint32_t>(uint64_t(n) * p / parts), static_cast<uint32_t>(uint64_t(n) * (p + 1) / parts));
+		});
+	}
+
+	void parallelFor(uint32_t n, const std::function<void(uint32_t)>& task) {
+		uint32_t threads = std::min(parallel_threads.load(std::memory_order_relaxed), n);
+		if (threads <= 1) {
+			for (uint32_t i = 0; i < n; ++i) task(i);
+			return;
+		}
+		//下标由执行者领取，只会等待正在执行的任务，嵌套调用也不会死锁
+		struct State {
+			std::atomic<uint32_t> next{ 0 };
+			uint32_t done{ 0 };
+			std::mutex mutex;
+			std::condition_variable cv;
+		};
+		auto state = std::make_shared<State>();
+		auto work = [state, n, &task] {
+			uint32_t finished{ 0 };
+			for (uint32_t i; (i = state->next.fetch_add(1)) < n; ++finished) task(i);
+			if (finished == 0) return;
+			std::lock_guard<std::mutex> lock(state->mutex);
+			state->done += finished;
+			if (state->done == n) state->cv.notify_all();
+		};
+		//没有领到下标的任务立即返回，此时task可能已经失效，所以只在领到下标后才使用它
+		for (uint32_t i = 1; i < threads; ++i) threadPool().push(work);
+		work();
+		std::unique_lock<std::mutex> lock(state->mutex);
+		state->cv.wait(lock, [&] { return state->done == n; });
+	}
+}
@@ -0,0 +1,326 @@
+#include<vector>
+#include<memory>
+#include<mutex>
+#include<cmath>
+#include<cstring>
+
+#include"src/Limbs.h"
+
+namespace limbs {
+	static const char digit_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+	//一个limb最多容纳chunk_digits位radix进制数字，chunk_base = radix^chunk_digits
+	struct RadixInfo {
+		int chunk_digits;
+		limb_t chunk_base;
+	};
+
+	static RadixInfo radixInfo(int radix) {
+		RadixInfo info{ 0, 1 };
+		while (dlimb_t(info.chunk_base) * radix <= 0xffffffffu) {
+			info.chunk_base *= radix;
+			++info.chunk_digits;
+		}
+		return info;
+	}
+
+	//2的幂进制每位的比特数，其它进制返回0
+	static int radixBits(int radix) {
+		if (radix & (radix - 1)) return 0;
+		int bits{ 0 };
+		while ((1 << bits) < radix) ++bits;
+		return bits;
+	}
+
+	uint32_t limbsForDigits(size_t n, int radix) {
+		//2的幂进制精确计算；其它进制的比值不会是整数，略微放大抵消浮点误差
+		if (int bits = radixBits(radix)) return static_cast<uint32_t>((uint64_t(n) * bits + limb_bits - 1) / limb_bits);
+		return static_cast<uint32_t>(std::ceil(n * std::log2(radix) / limb_bits * (1 + 1e-12)));
+	}
+
+	//分治转换时乘积按hn + pn个limb写出，比结果的上界最多多出2个limb
+	static uint32_t recursiveLimbs(size_t n, int radix) {
+		return limbsForDigits(n, radix) + 3;
+	}
+
+	size_t digitsForLimbs(uint32_t an, int radix) {
+		return static_cast<size_t>(std::ceil(an * double(limb_bits) / std::log2(radix))) + 1;
+	}
+
+	size_t minDigits(const limb_t* a, uint32_t an, int radix) {
+		if (an == 0) return 1;
+		//a >= 2^(bits - 1)，乘上略小于1的系数抵消浮点误差，结果只会偏小
+		uint64_t bits = uint64_t(an) * limb_bits - countLeadingZeros(a[an - 1]);
+		return static_cast<size_t>(double(bits - 1) / std::log2(radix) * (1 - 1e-12)) + 1;
+	}
+
+	//powers[k] = chunk_base^(2^k)，每种进制一张表，只会在末尾追加
+	using RadixPowers = std::vector<std::vector<limb_t>>;
+
+	//返回的表中最后一项至少有min_size个limb，且至少有min_count项
+	static std::shared_ptr<const RadixPowers> radixPowers(int radix, uint32_t min_size, size_t min_count = 0) {
+		static std::mutex powers_mutex;
+		static std::shared_ptr<const RadixPowers> powers[37];
+		std::lock_guard<std::mutex> lock(powers_mutex);
+		auto& cached = powers[radix];
+		if (!cached || cached->back().size() < min_size || cached->size() < min_count) {
+			auto table = cached ? std::make_shared<RadixPowers>(*cached) : std::make_shared<RadixPowers>(1, std::vector<limb_t>{ radixInfo(radix).chunk_base });
+			while (table->back().size() < min_size || table->size() < min_count) {
+				const std::vector<limb_t>& last = table->back();
+				uint32_t n = static_cast<uint32_t>(last.size());
+				std::vector<limb_t> sq(2 * n);
+				mul(sq.data(), last.data(), n, last.data(), n);
+				sq.resize(normalizedSize(sq.data(), 2 * n));
+				table->push_back(std::move(sq));
+			}
+			cached = table;
+		}
+		return cached;
+	}
+
+	size_t countDigits(const limb_t* a, uint32_t an, int radix) {
+		if (an == 0) return 1;
+		uint64_t bits = uint64_t(an) * limb_bits - countLeadingZeros(a[an - 1]);
+		if (int b = radixBits(radix)) return static_cast<size_t>((bits + b - 1) / b);
+		//最高的三个limb足够确定对数的小数部分，离整数足够远时直接得到位数
+		double top{ 0 };
+		for (uint32_t i = an; i-- > 0 && i + 3 >= an;) top = top * 4294967296.0 + a[i];
+		double estimate = std::log(top) / std::log(double(radix)) + double(an > 3 ? an - 3 : 0) * limb_bits / std::log2(double(radix));
+		//估计的误差只有几个ulp，留出足够的余量
+		double eps = 1e-9 + 1e-14 * estimate;
+		if (std::floor(estimate - eps) == std::floor(estimate + eps)) return static_cast<size_t>(estimate) + 1;
+		//a接近radix的整次幂，用radix^k精确比较：k = floor(estimate + eps)时a >= radix^k就有k + 1位
+		size_t k = static_cast<size_t>(estimate + eps);
+		RadixInfo info = radixInfo(radix);
+		size_t q = k / info.chunk_digits;
+		std::vector<limb_t> power{ 1 }, t;
+		if (q) {
+			size_t levels{ 0 };
+			while ((q >> levels) > 1) ++levels;
+			auto powers = radixPowers(radix, 0, levels + 1);
+			for (size_t i = 0; i <= levels; ++i) {
+				if (!((q >> i) & 1)) continue;
+				const std::vector<limb_t>& p = (*powers)[i];
+				t.assign(power.size() + p.size(), 0);
+				if (power.size() >= p.size()) mul(t.data(), power.data(), uint32_t(power.size()), p.data(), uint32_t(p.size()));
+				else mul(t.data(), p.data(), uint32_t(p.size()), power.data(), uint32_t(power.size()));
+				t.resize(normalizedSize(t.data(), uint32_t(t.size())));
+				power.swap(t);
+			}
+		}
+		for (size_t r = k % info.chunk_digits; r > 0; --r) {
+			limb_t carry = mulBySingle(power.data(), power.data(), uint32_t(power.size()), limb_t(radix));
+			if (carry) power.push_back(carry);
+		}
+		return compare(a, an, power.data(), uint32_t(power.size())) >= 0 ? k + 1 : k;
+	}
+
+	//低于这个limb数时逐个chunk乘除chunk_base，o(n^2)但常数很小
+	constexpr uint32_t radix_basecase = 32;
+	//powers[radix_basecase_level] = chunk_base^radix_basecase
+	constexpr size_t radix_basecase_level = 5;
+	static_assert((size_t(1) << radix_basecase_level) == radix_basecase, "radix_basecase must be 2^radix_basecase_level");
+
+	static uint32_t fromCharsPow2(limb_t* res, const char* first, const char* last, int bits) {
+		uint32_t size{ 0 };
+		dlimb_t acc{ 0 };
+		int acc_bits{ 0 };
+		while (last != first) {
+			acc |= dlimb_t(digitValue(*--last)) << acc_bits;
+			acc_bits += bits;
+			if (acc_bits >= limb_bits) {
+				res[size++] = limb_t(acc);
+				acc >>= limb_bits;
+				acc_bits -= limb_bits;
+			}
+		}
+		if (acc_bits > 0) res[size++] = limb_t(acc);
+		return normalizedSize(res, size);
+	}
+
+	static uint32_t fromCharsBasecase(limb_t* res, const char* first, const char* last, int radix, const RadixInfo& info) {
+		//先处理不足chunk_digits位的最高一段，之后每段乘chunk_base再加上
+		size_t len = last - first;
+		uint32_t size{ 0 };
+		size_t head = len % info.chunk_digits == 0 ? info.chunk_digits : len % info.chunk_digits;
+		while (first != last) {
+			limb_t chunk{ 0 };
+			for (const char* chunk_end = first + head; first != chunk_end; ++first) {
+				chunk = chunk * radix + digitValue(*first);
+			}
+			head = info.chunk_digits;
+			limb_t carry = mulBySingle(res, res, size, info.chunk_base);
+			if (carry) res[size++] = carry;
+			if (chunk == 0) continue;
+			if (size == 0) res[size++] = chunk;
+			else {
+				carry = add(res, res, size, &chunk, 1);
+				if (carry) res[size++] = carry;
+			}
+		}
+		return size;
+	}
+
+	//高半部分乘上chunk_base^(2^k)再加低半部分，低半部分恰好有chunk_digits * 2^k位
+	static uint32_t fromCharsRecursive(limb_t* res, const char* first, const char* last, int radix, const RadixInfo& info, const RadixPowers& powers) {
+		size_t len = last - first;
+		if (len <= size_t(info.chunk_digits) * radix_basecase) return fromCharsBasecase(res, first, last, radix, info);
+		size_t k{ 0 };
+		while (k + 1 < powers.size() && (size_t(info.chunk_digits) << (k + 1)) < len) ++k;
+		size_t low_len = size_t(info.chunk_digits) << k;
+		std::vector<limb_t> high(recursiveLimbs(len - low_len, radix)), low(recursiveLimbs(low_len, radix));
+		uint32_t hn = fromCharsRecursive(high.data(), first, last - low_len, radix, info, powers);
+		uint32_t ln = fromCharsRecursive(low.data(), last - low_len, last, radix, info, powers);
+		if (hn == 0) {
+			std::memcpy(res, low.data(), ln * sizeof(limb_t));
+			return ln;
+		}
+		const std::vector<limb_t>& p = powers[k];
+		uint32_t pn = static_cast<uint32_t>(p.size());
+		mul(res, high.data(), hn, p.data(), pn);
+		//low < p，不会进位到hn + pn之外
+		add(res, res, hn + pn, low.data(), ln);
+		return normalizedSize(res, hn + pn);
+	}
+
+	uint32_t fromChars(limb_t* res, const char* first, const char* last, int radix) {
+		if (int bits = radixBits(radix)) return fromCharsPow2(res, first, last, bits);
+		RadixInfo info = radixInfo(radix);
+		size_t len = last - first;
+		if (len <= size_t(info.chunk_digits) * radix_basecase) return fromCharsBasecase(res, first, last, radix, info);
+		//最大用到的幂约有总长度一半的limb
+		auto powers = radixPowers(radix, limbsForDigits(len / 2, radix) - 1);
+		//res只有limbsForDigits个limb，先写到留有余量的空间
+		std::vector<limb_t> scratch(recursiveLimbs(len, radix));
+		uint32_t size = fromCharsRecursive(scratch.data(), first, last, radix, info, *powers);
+		std::memcpy(res, scratch.data(), size * sizeof(limb_t));
+		return size;
+	}
+
+	//high * p + low，要求low < p
+	static std::vector<limb_t> combine(const std::vector<limb_t>& high, const std::vector<limb_t>& p, std::vector<limb_t>&& low) {
+		if (high.empty()) return std::move(low);
+		uint32_t hn = static_cast<uint32_t>(high.size()), pn = static_cast<uint32_t>(p.size());
+		std::vector<limb_t> ret(hn + pn);
+		mul(ret.data(), high.data(), hn, p.data(), pn);
+		add(ret.data(), ret.data(), hn + pn, low.data(), static_cast<uint32_t>(low.size()));
+		ret.resize(normalizedSize(ret.data(), hn + pn));
+		return ret;
+	}
+
+	DigitAccumulator::DigitAccumulator(int radix) : _radix{ radix } {
+		_block = size_t(radixInfo(radix).chunk_digits) * radix_basecase;
+		static_assert(31 * radix_basecase <= max_block_digits, "binary has the longest blocks");
+	}
+
+	void DigitAccumulator::flush() {
+		RadixInfo info = radixInfo(_radix);
+		std::vector<limb_t> low(limbsForDigits(_len, _radix));
+		low.resize(fromCharsBasecase(low.data(), _digits, _digits + _len, _radix, info));
+		_total += _len;
+		_len = 0;
+		//像二进制计数器一样，与栈顶同级的段合并后升一级
+		uint32_t level{ 0 };
+		while (!_segments.empty() && _segments.back().level == level) {
+			auto powers = radixPowers(_radix, 0, radix_basecase_level + level + 1);
+			low = combine(_segments.back().limbs, (*powers)[radix_basecase_level + level], std::move(low));
+			_segments.pop_back();
+			++level;
+		}
+		_segments.push_back({ level, std::move(low) });
+	}
+
+	uint32_t DigitAccumulator::finish(limb_t* res) {
+		RadixInfo info = radixInfo(_radix);
+		if (_segments.empty()) return fromCharsBasecase(res, _digits, _digits + _len, _radix, info);
+		//从最高的段开始，每次乘上下一段长度对应的幂再加上下一段
+		std::vector<limb_t> acc = std::move(_segments.front().limbs);
+		for (size_t i = 1; i < _segments.size(); ++i) {
+			auto powers = radixPowers(_radix, 0, radix_basecase_level + _segments[i].level + 1);
+			acc = combine(acc, (*powers)[radix_basecase_level + _segments[i].level], std::move(_segments[i].limbs));
+		}
+		if (_len > 0) {
+			//不足一块的尾部，乘上radix^_len后加上
+			std::vector<limb_t> p{ 1 }, low(limbsForDigits(_len, _radix));
+			size_t rest{ _len };
+			limb_t m{ 1 };
+			for (; rest >= size_t(info.chunk_digits); rest -= info.chunk_digits) {
+				limb_t carry = mulBySingle(p.data(), p.data(), static_cast<uint32_t>(p.size()), info.chunk_base);
+				if (carry) p.push_back(carry);
+			}
+			for (; rest > 0; --rest) m *= _radix;
+			limb_t carry = mulBySingle(p.data(), p.data(), static_cast<uint32_t>(p.size()), m);
+			if (carry) p.push_back(carry);
+			low.resize(fromCharsBasecase(low.data(), _digits, _digits + _len, _radix, info));
+			acc = combine(acc, p, std::move(low));
+		}
+		_segments.clear();
+		_total += _len;
+		_len = 0;
+		std::memcpy(res, acc.data(), acc.size() * sizeof(limb_t));
+		return static_cast<uint32_t>(acc.size());
+	}
+
+	static bool toCharsPow2(char* res, size_t len, const limb_t* a, uint32_t an, int bits) {
+		limb_t mask = (limb_t(1) << bits) - 1;
+		for (size_t i = 0; i < len; ++i) {
+			size_t bit = i * bits;
+			size_t index = bit / limb_bits;
+			int offset = static_cast<int>(bit % limb_bits);
+			limb_t digit{ 0 };
+			if (index < an) {
+				digit = a[index] >> offset;
+				if (offset + bits > limb_bits && index + 1 < an) digit |= a[index + 1] << (limb_bits - offset);
+			}
+			res[len - 1 - i] = digit_chars[digit & mask];
+		}
+		if (an == 0) return true;
+		uint64_t bit_length = uint64_t(an) * limb_bits - countLeadingZeros(a[an - 1]);
+		return bit_length <= uint64_t(len) * bits;
+	}
+
+	static bool toCharsBasecase(char* res, size_t len, const limb_t* a, uint32_t an, int radix, const RadixInfo& info) {
+		limb_t stack_quo[radix_basecase];
+		std::vector<limb_t> heap_quo;
+		limb_t* quo = stack_quo;
+		if (an > radix_basecase) {
+			heap_quo.resize(an);
+			quo = heap_quo.data();
+		}
+		std::memcpy(quo, a, an * sizeof(limb_t));
+		//每次除以chunk_base得到低chunk_digits位，从右向左写
+		char* pos = res + len;
+		limb_t chunk{ 0 };
+		while (an > 0 && pos != res) {
+			chunk = divBySingle(quo, quo, an, info.chunk_base);
+			an = normalizedSize(quo, an);
+			for (int j = 0; j < info.chunk_digits && pos != res; ++j, chunk /= radix) *--pos = digit_chars[chunk % radix];
+		}
+		std::memset(res, '0', pos - res);
+		//写满len位之后还有剩下的数字说明放不下
+		return an == 0 && chunk == 0;
+	}
+
+	//除以chunk_base^(2^k)，余数恰好占低chunk_digits * 2^k位，商和余数分别递归
+	static bool toCharsRecursive(char* res, size_t len, const limb_t* a, uint32_t an, int radix, const RadixInfo& info, const RadixPowers& powers) {
+		if (an <= radix_basecase) return toCharsBasecase(res, len, a, an, radix, info);
+		size_t k{ 0 };
+		while (k + 1 < powers.size() && 2 * powers[k + 1].size() <= an + 1 && (size_t(info.chunk_digits) << (k + 1)) < len) ++k;
+		const std::vector<limb_t>& p = powers[k];
+		uint32_t pn = static_cast<uint32_t>(p.size());
+		size_t low_len = size_t(info.chunk_digits) << k;
+		std::vector<limb_t> q(an - pn + 1), r(pn);
+		divmod(q.data(), r.data(), a, an, p.data(), pn);
+		//余数恰好有low_len位，是否放得下只取决于商
+		toCharsRecursive(res + len - low_len, low_len, r.data(), normalizedSize(r.data(), pn), radix, info, powers);
+		return toCharsRecursive(res, len - low_len, q.data(), normalizedSize(q.data(), an - pn + 1), radix, info, powers);
+	}
+
+	bool toChars(char* res, size_t len, const limb_t* a, uint32_t an, int radix) {
+		if (int bits = radixBits(radix)) return toCharsPow2(res, len, a, an, bits);
+		RadixInfo info = radixInfo(radix);
+		if (an <= radix_basecase) return toCharsBasecase(res, len, a, an, radix, info);
+		auto powers = radixPowers(radix, (an + 1) / 2);
+		return toCharsRecursive(res, len, a, an, radix, info, *powers);
+	}
+}
@@ -0,0 +1,253 @@
+#include<vector>
+#include<algorithm>
+#include<cmath>
+
+#include"src/Limbs.h"
+
+namespace limbs {
+	using Natural = std::vector<limb_t>;
+
+	static void trim(Natural& x) {
+		x.resize(normalizedSize(x.data(), static_cast<uint32_t>(x.size())));
+	}
+
+	static uint32_t sizeOf(const Natural& x) {
+		return static_cast<uint32_t>(x.size());
+	}
+
+	static Natural fromWord(dlimb_t v) {
+		Natural ret{ static_cast<limb_t>(v), static_cast<limb_t>(v >> limb_bits) };
+		trim(ret);
+		return ret;
+	}
+
+	static Natural mulNatural(const Natural& x, const Natural& y) {
+		if (x.empty() || y.empty()) return Natural();
+		Natural ret(x.size() + y.size());
+		if (&x == &y) sqr(ret.data(), x.data(), sizeOf(x));
+		else if (x.size() >= y.size()) mul(ret.data(), x.data(), sizeOf(x), y.data(), sizeOf(y));
+		else mul(ret.data(), y.data(), sizeOf(y), x.data(), sizeOf(x));
+		trim(ret);
+		return ret;
+	}
+
+	static int compareNatural(const Natural& x, const Natural& y) {
+		return compare(x.data(), sizeOf(x), y.data(), sizeOf(y));
+	}
+
+	static void addNatural(Natural& x, const Natural& y) {
+		if (x.size() < y.size()) x.resize(y.size(), 0);
+		x.push_back(0);
+		add(x.data(), x.data(), sizeOf(x), y.data(), sizeOf(y));
+		trim(x);
+	}
+
+	//要求x >= y
+	static void subNatural(Natural& x, const Natural& y) {
+		sub(x.data(), x.data(), sizeOf(x), y.data(), sizeOf(y));
+		trim(x);
+	}
+
+	static uint64_t bitLength(const limb_t* a, uint32_t an) {
+		return an == 0 ? 0 : uint64_t(an) * limb_bits - countLeadingZeros(a[an - 1]);
+	}
+
+	//x >> bits
+	static Natural shiftRight(const Natural& x, uint64_t bits) {
+		uint64_t skip = bits / limb_bits;
+		if (skip >= x.size()) return Natural();
+		Natural ret(x.begin() + skip, x.end());
+		rshift(ret.data(), ret.data(), sizeOf(ret), static_cast<int>(bits % limb_bits));
+		trim(ret);
+		return ret;
+	}
+
+	//x << bits
+	static Natural shiftLeft(const Natural& x, uint64_t bits) {
+		if (x.empty()) return Natural();
+		Natural ret(bits / limb_bits + x.size() + 1, 0);
+		limb_t* high = ret.data() + bits / limb_bits;
+		high[x.size()] = lshift(high, x.data(), sizeOf(x), static_cast<int>(bits % limb_bits));
+		trim(ret);
+		return ret;
+	}
+
+	//x^e, e >= 1，从高位到低位的二进制快速幂
+	static Natural powNatural(const Natural& x, uint32_t e) {
+		Natural ret = x;
+		for (int i = 30 - countLeadingZeros(e); i >= 0; --i) {
+			ret = mulNatural(ret, ret);
+			if ((e >> i) & 1) ret = mulNatural(ret, x);
+		}
+		return ret;
+	}
+
+	//floor(x / y)，y != 0
+	static Natural divNatural(const Natural& x, const Natural& y) {
+		if (compareNatural(x, y) < 0) return Natural();
+		Natural q(x.size() - y.size() + 1), r(y.size());
+		divmod(q.data(), r.data(), x.data(), sizeOf(x), y.data(), sizeOf(y));
+		trim(q);
+		return q;
+	}
+
+	//a^(1/n)的double估计，结果不超过2^32时误差在1以内
+	static dlimb_t rootEstimate(const limb_t* a, uint32_t an, uint32_t n) {
+		uint64_t bits = bitLength(a, an);
+		//只取最高的64位
+		uint64_t drop = bits > 64 ? bits - 64 : 0;
+		Natural top = shiftRight(Natural(a + drop / limb_bits, a + an), drop % limb_bits);
+		double lg = std::log2(double(top.size() > 1 ? dlimb_t(top[1]) << limb_bits | top[0] : top[0])) + double(drop);
+		return static_cast<dlimb_t>(std::min(std::exp2(lg / n), 4294967296.0) + 0.5);
+	}
+
+	//根不超过32位时从double估计开始逐个修正
+	static Natural rootBasecase(const Natural& x, uint32_t n) {
+		dlimb_t y = rootEstimate(x.data(), sizeOf(x), n);
+		auto cmp = [&](dlimb_t v) { return v == 0 ? -1 : compareNatural(powNatural(fromWord(v), n), x); };
+		while (cmp(y) > 0) --y;
+		while (cmp(y + 1) <= 0) ++y;
+		return fromWord(y);
+	}
+
+	//floor(x^(1/n))，n >= 2，x != 0
+	//先递归求出x >> nk的根r，(r + 1) << k从上方逼近，误差不超过2^k
+	//k约为根的位数的一半，一步牛顿迭代后误差就小于1，之后最多修正一两次
+	static Natural rootNatural(const Natural& x, uint32_t n) {
+		uint64_t root_bits = (bitLength(x.data(), sizeOf(x)) + n - 1) / n;
+		if (root_bits <= limb_bits) return rootBasecase(x, n);
+		uint64_t n_bits = limb_bits - countLeadingZeros(n);
+		uint64_t k = root_bits > 2 * n_bits + 4 ? (root_bits - 2 * n_bits - 2) / 2 : 1;
+		Natural y = rootNatural(shiftRight(x, n * k), n);
+		addNatural(y, Natural{ 1 });
+		y = shiftLeft(y, k);
+		//y = ((n - 1)y + x / y^(n - 1)) / n，y不会降到根以下
+		Natural q = divNatural(x, n == 2 ? y : powNatural(y, n - 1));
+		Natural t(y.size() + 1);
+		t[y.size()] = mulBySingle(t.data(), y.data(), sizeOf(y), n - 1);
+		trim(t);
+		addNatural(t, q);
+		divBySingle(t.data(), t.data(), sizeOf(t), n);
+		trim(t);
+		while (compareNatural(powNatural(t, n), x) > 0) subNatural(t, Natural{ 1 });
+		return t;
+	}
+
+	uint32_t iroot(limb_t* res, const limb_t* a, uint32_t an, uint32_t n) {
+		if (n == 1) {
+			std::copy(a, a + an, res);
+			return an;
+		}
+		if (n == 2 && an <= 2) {
+			//机器字直接用double开方再修正
+			dlimb_t v = an > 1 ? dlimb_t(a[1]) << limb_bits | a[0] : a[0];
+			dlimb_t y = std::min<dlimb_t>(static_cast<dlimb_t>(std::sqrt(double(v))), 0xffffffffu);
+			while (y * y > v) --y;
+			while (y < 0xffffffffu && (y + 1) * (y + 1) <= v) ++y;
+			res[0] = static_cast<limb_t>(y);
+			return 1;
+		}
+		Natural y = rootNatural(Natural(a, a + an), n);
+		std::copy(y.begin(), y.end(), res);
+		return sizeOf(y);
+	}
+
+	static limb_t modSingle(const limb_t* a, uint32_t an, limb_t d) {
+		dlimb_t rem{ 0 };
+		while (an > 0) rem = ((rem << limb_bits) | a[--an]) % d;
+		return static_cast<limb_t>(rem);
+	}
+
+	static uint64_t powMod(uint64_t b, uint64_t e, uint64_t m) {
+		uint64_t ret{ 1 };
+		for (b %= m; e > 0; e >>= 1) {
+			if (e & 1) ret = ret * b % m;
+			b = b * b % m;
+		}
+		return ret;
+	}
+
+	bool isPerfectSquare(const limb_t* a, uint32_t an) {
+		if (an == 0) return true;
+		//平方数模64只有12种剩余
+		static const uint64_t squares_mod64 = [] {
+			uint64_t mask{ 0 };
+			for (uint64_t i = 0; i < 32; ++i) mask |= uint64_t(1) << (i * i % 64);
+			return mask;
+		}();
+		if (!((squares_mod64 >> (a[0] & 63)) & 1)) return false;
+		//B = 2^32 ≡ 1 (mod 2^32 - 1)，各limb相加就得到模2^32 - 1的剩余，再按它的素因子用欧拉判别法
+		uint64_t sum{ 0 };
+		for (uint32_t i = 0; i < an; ++i) sum += a[i];
+		sum = (sum & 0xffffffffu) + (sum >> limb_bits);
+		for (uint64_t p : { 3u, 5u, 17u, 257u, 65537u }) {
+			uint64_t r = sum % p;
+			if (r != 0 && powMod(r, (p - 1) / 2, p) != 1) return false;
+		}
+		//剩下约1%的数才真正开方
+		Natural x(a, a + an);
+		Natural y = rootNatural(x, 2);
+		return compareNatural(mulNatural(y, y), x) == 0;
+	}
+
+	static bool isPrime(uint64_t p) {
+		if (p < 2) return false;
+		for (uint64_t d = 2; d * d <= p; ++d) {
+			if (p % d == 0) return false;
+		}
+		return true;
+	}
+
+	//x是p次方数时，对素数q = 2jp + 1，x mod q的(q - 1) / p次方为0或1，非p次方数大约只有1 / p的概率通过
+	static bool powerResidueTest(const limb_t* a, uint32_t an, uint32_t p) {
+		int tested{ 0 };
+		for (uint64_t q = 2 * uint64_t(p) + 1; q < 0xffffffffu && tested < 3; q += 2 * uint64_t(p)) {
+			if (!isPrime(q)) continue;
+			uint64_t r = modSingle(a, an, static_cast<limb_t>(q));
+			if (r != 0 && powMod(r, (q - 1) / p, q) != 1) return false;
+			++tested;
+		}
+		return true;
+	}
+
+	bool isPerfectPower(const limb_t* a, uint32_t an, bool odd_only) {
+		uint64_t bits = bitLength(a, an);
+		if (bits <= 1) return true;
+		if (!odd_only && isPerfectSquare(a, an)) return true;
+		//x = 2^t * 奇数是p次方数时p | t
+		uint32_t zeros{ 0 };
+		while (a[zeros] == 0) ++zeros;
+		uint64_t t = uint64_t(zeros) * limb_bits + countTrailingZeros(a[zeros]);
+		//2^t = 2^(t / k)^k
+		if (t == bits - 1) return odd_only ? (t & (t - 1)) != 0 : t >= 2;
+		Natural x(a, a + an);
+		//只需要检查不超过位数的奇素数
+		std::vector<bool> composite(bits + 1, false);
+		for (uint64_t p = 3; p <= bits; p += 2) {
+			if (composite[p]) continue;
+			for (uint64_t m = p * p; m <= bits; m += 2 * p) composite[m] = true;
+			if (t > 0 && t % p != 0) continue;
+			uint32_t e = static_cast<uint32_t>(p);
+			uint64_t root_bits = (bits + p - 1) / p;
+			if (root_bits > limb_bits) {
+				if (!powerResidueTest(a, an, e)) continue;
+			}
+			else {
+				//根很短时先在模2^64下比较估计值附近的几个候选，避免整个长度上的乘方
+				dlimb_t y = rootEstimate(a, an, e);
+				dlimb_t low = an > 1 ? dlimb_t(a[1]) << limb_bits | a[0] : a[0];
+				bool candidate{ false };
+				for (dlimb_t c = y > 0 ? y - 1 : 0; c <= y + 1; ++c) {
+					dlimb_t pw{ 1 }, b{ c };
+					for (uint32_t k = e; k > 0; k >>= 1, b *= b) {
+						if (k & 1) pw *= b;
+					}
+					candidate = candidate || pw == low;
+				}
+				if (!candidate) continue;
+			}
+			if (compareNatural(powNatural(rootNatural(x, e), e), x) == 0) return true;
+		}
+		return false;
+	}
+}
@@ -0,0 +1,143 @@
+#include<stdexcept>
+#include<cstring>
+#include<limits>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include<Windows.h>
+#else
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<fcntl.h>
+#include<unistd.h>
+#endif
+
+#include"src/Serialize.h"
+
+//写出时直接输出内存中的limb，读取时视图直接引用数据，都依赖机器本身是小端序
+//MSVC支持的平台都是小端序；其它编译器在大端序机器上直接报错，而不是产生不兼容的文件
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "the BigInt binary format requires a little-endian host");
+#endif
+
+static const char bigint_magic[4] = { 'B', 'I', 'G', 'I' };
+constexpr size_t bigint_header_size = 8;
+
+BigInt BigIntView::value() const {
+	BigInt ret;
+	if (_nan) return ret;
+	ret.reserve(_size);
+	if (_size > 0) std::memcpy(ret._limbs, _limbs, _size * sizeof(limb_t));
+	ret._size = _size;
+	ret._sign = _sign;
+	ret.normalize();
+	return ret;
+}
+
+BigIntWriter::BigIntWriter(std::ostream& o) :_o{ o }, _offset{ bigint_header_size } {
+	char header[bigint_header_size] = { bigint_magic[0], bigint_magic[1], bigint_magic[2], bigint_magic[3], static_cast<char>(bigint_binary_version), 0, 0, 0 };
+	_o.write(header, bigint_header_size);
+}
+
+BigIntWriter& BigIntWriter::write(const BigInt& bInt) {
+	uint32_t size = bInt.isNaN() ? 0 : bInt._size;
+	uint64_t tag = (uint64_t(size) << 2) | (uint64_t(bInt.isNaN()) << 1) | uint64_t(!bInt.isNaN() && !bInt._sign);
+	//varint最多10字节，再加最多3字节的对齐
+	char buf[16];
+	size_t len{ 0 };
+	do {
+		unsigned char byte = tag & 0x7f;
+		tag >>= 7;
+		buf[len++] = static_cast<char>(tag ? byte | 0x80 : byte);
+	} while (tag);
+	if (size > 0) {
+		while ((_offset + len) % sizeof(BigInt::limb_t)) buf[len++] = 0;
+	}
+	_o.write(buf, len);
+	//小端序机器上limb在内存中的字节顺序就是文件格式，直接写出
+	_o.write(reinterpret_cast<const char*>(bInt._limbs), std::streamsize(size) * sizeof(BigInt::limb_t));
+	_offset += len + uint64_t(size) * sizeof(BigInt::limb_t);
+	return *this;
+}
+
+BigIntReader::BigIntReader(const void* data, size_t size) :_data{ static_cast<const unsigned char*>(data) }, _size{ size }, _pos{ bigint_header_size } {
+	if (reinterpret_cast<uintptr_t>(data) % sizeof(BigInt::limb_t)) throw std::invalid_argument("BigInt data must be 4-byte aligned");
+	if (size < bigint_header_size || std::memcmp(data, bigint_magic, sizeof(bigint_magic)) != 0) throw std::runtime_error("not BigInt binary data");
+	if (_data[4] != bigint_binary_version) throw std::runtime_error("unsupported BigInt binary version");
+}
+
+bool BigIntReader::next(BigIntView& view) {
+	if (_pos == _size) return false;
+	uint64_t tag{ 0 };
+	for (int shift = 0;; shift += 7) {
+		if (_pos == _size || shift > 63) throw std::runtime_error("corrupted BigInt data");
+		unsigned char byte = _data[_pos++];
+		tag |= uint64_t(byte & 0x7f) << shift;
+		if (!(byte & 0x80)) break;
+	}
+	uint64_t size = tag >> 2;
+	bool nan = tag & 2, negative = tag & 1;
+	if (size > std::numeric_limits<uint32_t>::max() || (nan && (size || negative)) || (size == 0 && negative)) {
+		throw std::runtime_error("corrupted BigInt data");
+	}
+	view._limbs = nullptr;
+	if (size > 0) {
+		_pos = (_pos + sizeof(BigInt::limb_t) - 1) & ~(sizeof(BigInt::limb_t) - 1);
+		if (_pos > _size || (_size - _pos) / sizeof(BigInt::limb_t) < size) throw std::runtime_error("truncated BigInt data");
+		view._limbs = reinterpret_cast<const BigInt::limb_t*>(_data + _pos);
+		if (view._limbs[size - 1] == 0) throw std::runtime_error("corrupted BigInt data");
+		_pos += size * sizeof(BigInt::limb_t);
+	}
+	view._size = static_cast<uint32_t>(size);
+	view._sign = !negative;
+	view._nan = nan;
+	return true;
+}
+
+#if defined(_WIN32)
+MappedBigIntFile::MappedBigIntFile(const std::string& path) {
+	_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (_file == INVALID_HANDLE_VALUE) {
+		_file = nullptr;
+		throw std::runtime_error("cannot open " + path);
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(_file, &size) || size.QuadPart == 0) {
+		CloseHandle(_file);
+		throw std::runtime_error("cannot map " + path);
+	}
+	_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	_data = _mapping ? MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (_data == nullptr) {
+		if (_mapping) CloseHandle(_mapping);
+		CloseHandle(_file);
+		throw std::runtime_error("cannot map " + path);
+	}
+	_size = static_cast<size_t>(size.QuadPart);
+}
+
+MappedBigIntFile::~MappedBigIntFile() {
+	UnmapViewOfFile(_data);
+	CloseHandle(_mapping);
+	CloseHandle(_file);
+}
+#else
+MappedBigIntFile::MappedBigIntFile(const std::string& path) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) throw std::runtime_error("cannot open " + path);
+	struct stat st;
+	void* data = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size > 0) {
+		data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	//映射建立后文件描述符可以直接关闭
+	close(fd);
+	if (data == MAP_FAILED) throw std::runtime_error("cannot map " + path);
+	_data = data;
+	_size = static_cast<size_t>(st.st_size);
+}
+
+MappedBigIntFile::~MappedBigIntFile() {
+	munmap(const_cast<void*>(_data), _size);
+}
+#endif
@@ -0,0 +1,74 @@
+#pragma once
+#include<src/BigInt_impl.h>
+#include<ostream>
+#include<string>
+#include<cstddef>
+
+//二进制格式，版本1
+//文件头8字节: "BIGI"，版本号，3个0
+//每个值: varint(limb个数 << 2 | NaN << 1 | 负号)，limb个数不为0时补0到4字节对齐，然后是小端序的limb
+//limb按4字节对齐存放，读取时直接引用，不需要复制；因此只支持小端序的机器
+constexpr unsigned char bigint_binary_version = 1;
+
+//指向已编码数据的只读视图，数据的生命周期由读取者管理
+class BigIntView {
+	friend class BigIntReader;
+public:
+	using limb_t = BigInt::limb_t;
+
+	bool isNaN() const { return _nan; }
+	//非负时为true
+	bool sign() const { return _sign; }
+	uint32_t size() const { return _size; }
+	//小端序的limb，规范化(最高位limb不为0)
+	const limb_t* limbs() const { return _limbs; }
+	//复制为BigInt
+	BigInt value() const;
+private:
+	const limb_t* _limbs{ nullptr };
+	uint32_t _size{ 0 };
+	bool _sign{ true };
+	bool _nan{ true };
+};
+
+//构造时写文件头，之后逐个追加值
+class BigIntWriter {
+public:
+	explicit BigIntWriter(std::ostream& o);
+	BigIntWriter& write(const BigInt& bInt);
+private:
+	std::ostream& _o;
+	uint64_t _offset;
+};
+
+//从内存中的编码数据依次读出视图，data必须4字节对齐且以文件头开始
+//格式错误时抛出std::runtime_error
+class BigIntReader {
+public:
+	BigIntReader(const void* data, size_t size);
+	//读完时返回false
+	bool next(BigIntView& view);
+private:
+	const unsigned char* _data;
+	size_t _size;
+	size_t _pos;
+};
+
+//把整个文件映射到内存，reader()读出的视图直接指向映射的内容，在此对象析构前有效
+class MappedBigIntFile {
+public:
+	explicit MappedBigIntFile(const std::string& path);
+	MappedBigIntFile(const MappedBigIntFile&) = delete;
+	MappedBigIntFile& operator=(const MappedBigIntFile&) = delete;
+	~MappedBigIntFile();
+
+	BigIntReader reader() const { return BigIntReader(_data, _size); }
+	size_t size() const { return _size; }
+private:
+	const void* _data{ nullptr };
+	size_t _size{ 0 };
+#if defined(_WIN32)
+	void* _file{ nullptr };
+	void* _mapping{ nullptr };
+#endif
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include<src/BigInt_impl.h>
+#include<atomic>
+#include<utility>
+
+//引用计数的不可变BigInt，拷贝只增加一次原子计数，适合把大的常量(模数、预计算表)分发给多个线程
+//多个线程可以同时读同一个值；同一个SharedBigInt对象本身和shared_ptr一样，不能在多个线程中同时修改
+class SharedBigInt {
+public:
+	SharedBigInt() :_node{ new Node{} } {}
+	SharedBigInt(const BigInt& value) :_node{ new Node{ 1, value } } {}
+	SharedBigInt(BigInt&& value) :_node{ new Node{ 1, std::move(value) } } {}
+	SharedBigInt(const SharedBigInt& other) :_node{ other._node } {
+		if (_node) _node->refs.fetch_add(1, std::memory_order_relaxed);
+	}
+	SharedBigInt(SharedBigInt&& other) noexcept :_node{ std::exchange(other._node, nullptr) } {}
+	SharedBigInt& operator=(SharedBigInt other) noexcept {
+		std::swap(_node, other._node);
+		return *this;
+	}
+	~SharedBigInt() { release(); }
+
+	const BigInt& get() const { return _node->value; }
+	const BigInt& operator*() const { return _node->value; }
+	const BigInt* operator->() const { return &_node->value; }
+	operator const BigInt& () const { return _node->value; }
+
+	//写时复制：与其它SharedBigInt共享时先复制一份，返回的引用在下次拷贝前有效
+	//计数用acquire读取，与其它线程读完后销毁拷贝时的release递减同步，独占时才能安全地原地修改
+	BigInt& mutate() {
+		if (_node->refs.load(std::memory_order_acquire) > 1) {
+			Node* copy = new Node{ 1, BigInt(_node->value, _node->value.resource()) };
+			release();
+			_node = copy;
+		}
+		return _node->value;
+	}
+	//共享同一个值的SharedBigInt个数
+	long useCount() const { return _node ? _node->refs.load(std::memory_order_relaxed) : 0; }
+
+	friend bool operator==(const SharedBigInt& l, const SharedBigInt& r) { return l._node == r._node ? !l->isNaN() : *l == *r; }
+	friend bool operator!=(const SharedBigInt& l, const SharedBigInt& r) { return !(l == r); }
+private:
+	struct Node {
+		std::atomic<long> refs{ 1 };
+		BigInt value;
+	};
+
+	void release() {
+		//最后一个拥有者销毁前要看到其它拥有者的全部读取
+		if (_node && _node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete _node;
+	}
+
+	Node* _node;
+};
@@ -1,4 +1,10 @@
+#include<stdexcept>
+#include<limits>
+#include<vector>
+#include<algorithm>
+
 #include<src/Util.h>
+#include<src/Modulus.h>
 
 bool util::sign(const BigInt& bInt) {
 	return bInt.sign();
@@ -8,11 +14,337 @@ uint32_t util::digits10(const BigInt& bInt) {
 	return bInt.digits10();
 }
 
-std::string util::to_string(const BigInt& bInt) {
-	std::string ret;
-	ret.resize(bInt.digits10() + !bInt._sign);
-	char* start = ret.data() + !bInt._sign;
-	memcpy(start, bInt._digits, bInt.digits10());
-	if (!bInt._sign) ret[0] = '-';
+static bool validBase(int base) {
+	return base >= 2 && base <= 36;
+}
+
+std::string util::to_string(const BigInt& bInt, int base) {
+	if (!validBase(base)) throw std::invalid_argument("base must be in [2, 36]");
+	std::string ret = bInt.toString(base);
+	if (!bInt.isNaN() && !bInt._sign) ret.insert(ret.begin(), '-');
 	return ret;
+}
+
+BigInt util::from_string(const std::string_view& str, int base) {
+	if (!validBase(base)) throw std::invalid_argument("base must be in [2, 36]");
+	BigInt ret;
+	const char* last = str.data() + str.size();
+	if (ret.parse(str.data(), last, base) != last) ret.free();
+	return ret;
+}
+
+std::to_chars_result util::to_chars(char* first, char* last, const BigInt& bInt, int base) {
+	if (bInt.isNaN() || !validBase(base)) return { first, std::errc::invalid_argument };
+	char* digits = first;
+	if (!bInt._sign) {
+		if (first == last) return { last, std::errc::value_too_large };
+		*digits++ = '-';
+	}
+	char* end = bInt.write(digits, last, base);
+	if (end == nullptr) return { last, std::errc::value_too_large };
+	return { end, std::errc() };
+}
+
+std::from_chars_result util::from_chars(const char* first, const char* last, BigInt& bInt, int base) {
+	if (!validBase(base)) return { first, std::errc::invalid_argument };
+	const char* end = bInt.parse(first, last, base);
+	if (end == first) return { first, std::errc::invalid_argument };
+	return { end, std::errc() };
+}
+
+std::pair<BigInt, BigInt> util::divmod(const BigInt& l, const BigInt& r) {
+	std::pair<BigInt, BigInt> ret{ BigInt(BigInt::resultResource(l, r)), BigInt(BigInt::resultResource(l, r)) };
+	BigInt::divide(l, r, &ret.first, &ret.second);
+	return ret;
+}
+
+std::pair<BigInt, long long> util::divmod(const BigInt& l, long long r) {
+	if (l.isNaN()) return { BigInt(), 0 };
+	if (r == 0) throw std::domain_error("divided by zero!");
+	unsigned long long magnitude = r < 0 ? 0ull - static_cast<unsigned long long>(r) : static_cast<unsigned long long>(r);
+	BigInt quotient(l._resource);
+	quotient.reserve(l._size);
+	unsigned long long rem;
+	if (magnitude <= std::numeric_limits<BigInt::limb_t>::max()) {
+		rem = limbs::divBySingle(quotient._limbs, l._limbs, l._size, static_cast<BigInt::limb_t>(magnitude));
+		quotient._size = l._size;
+	}
+	else if (l._size < 2) {
+		rem = l._size == 0 ? 0 : l._limbs[0];
+	}
+	else {
+		BigInt::limb_t divisor[2] = { static_cast<BigInt::limb_t>(magnitude), static_cast<BigInt::limb_t>(magnitude >> 32) };
+		BigInt::limb_t remainder[2];
+		limbs::divmodBasecase(quotient._limbs, remainder, l._limbs, l._size, divisor, 2);
+		rem = (static_cast<unsigned long long>(remainder[1]) << 32) | remainder[0];
+		quotient._size = l._size - 1;
+	}
+	quotient._sign = l._sign == (r > 0);
+	quotient.normalize();
+	//|rem| < |r|，转换回有符号数不会溢出
+	long long srem = static_cast<long long>(rem);
+	return { std::move(quotient), l._sign ? srem : -srem };
+}
+
+BigInt util::square(const BigInt& x) {
+	if (x.isNaN()) return BigInt();
+	BigInt ret(x._resource);
+	ret.reserve(2 * x._size);
+	limbs::sqr(ret._limbs, x._limbs, x._size);
+	ret._size = 2 * x._size;
+	ret.normalize();
+	return ret;
+}
+
+BigInt util::pow(const BigInt& base, uint64_t exp) {
+	if (base.isNaN()) return BigInt();
+	BigInt ret(base._resource);
+	if (exp == 0 || base._size == 0) {
+		ret.assign(exp == 0, true);
+		return ret;
+	}
+	bool sign = base._sign || !(exp & 1);
+	uint32_t bn{ base._size };
+	uint64_t bits = uint64_t(bn) * limbs::limb_bits - limbs::countLeadingZeros(base._limbs[bn - 1]);
+	//结果不超过bits * exp位
+	if (exp > (uint64_t(std::numeric_limits<uint32_t>::max() - 2) * limbs::limb_bits) / bits) throw std::overflow_error("BigInt too large");
+	uint64_t result_bits = bits * exp;
+	if (limbs::normalizedSize(base._limbs, bn - 1) == 0 && (base._limbs[bn - 1] & (base._limbs[bn - 1] - 1)) == 0) {
+		//2^k的幂只有一个1
+		uint64_t shift = result_bits - exp;
+		uint32_t size = static_cast<uint32_t>(shift / limbs::limb_bits) + 1;
+		ret.reserve(size);
+		std::fill(ret._limbs, ret._limbs + size, 0);
+		ret._limbs[size - 1] = BigInt::limb_t(1) << (shift % limbs::limb_bits);
+		ret._size = size;
+		ret._sign = sign;
+		return ret;
+	}
+	//中间结果都不超过最终结果，平方和乘法写出的长度最多多出两个limb
+	uint32_t cap = static_cast<uint32_t>((result_bits + limbs::limb_bits - 1) / limbs::limb_bits) + 2;
+	//cap按bits * exp估计，可能比结果多出几个limb；较小时先在栈上计算，最后按实际长度分配，放得进对象内部时就不分配内存
+	constexpr uint32_t stack_limbs = 16;
+	BigInt::limb_t local[2 * stack_limbs];
+	std::vector<BigInt::limb_t> temp;
+	BigInt::limb_t* x = local;
+	BigInt::limb_t* y = local + stack_limbs;
+	if (cap > stack_limbs) {
+		ret.reserve(cap);
+		temp.resize(cap);
+		x = ret._limbs;
+		y = temp.data();
+	}
+	std::copy(base._limbs, base._limbs + bn, x);
+	uint32_t xn{ bn };
+	int top{ 63 };
+	while (!((exp >> top) & 1)) --top;
+	for (int i = top - 1; i >= 0; --i) {
+		limbs::sqr(y, x, xn);
+		xn = limbs::normalizedSize(y, 2 * xn);
+		std::swap(x, y);
+		if ((exp >> i) & 1) {
+			if (bn == 1) {
+				x[xn] = limbs::mulBySingle(x, x, xn, base._limbs[0]);
+				xn = limbs::normalizedSize(x, xn + 1);
+			}
+			else {
+				limbs::mul(y, x, xn, base._limbs, bn);
+				xn = limbs::normalizedSize(y, xn + bn);
+				std::swap(x, y);
+			}
+		}
+	}
+	if (x != ret._limbs) {
+		ret.reserve(xn);
+		std::copy(x, x + xn, ret._limbs);
+	}
+	ret._size = xn;
+	ret._sign = sign;
+	return ret;
+}
+
+BigInt util::powmod(const BigInt& base, const BigInt& exp, const BigInt& m) {
+	return Modulus(m).pow(base, exp);
+}
+
+BigInt util::gcd(const BigInt& a, const BigInt& b) {
+	if (a.isNaN() || b.isNaN()) return BigInt();
+	BigInt ret(BigInt::resultResource(a, b));
+	if (a._size == 0 || b._size == 0) {
+		ret = a._size == 0 ? b : a;
+		ret._sign = true;
+		return ret;
+	}
+	ret.reserve(std::min(a._size, b._size));
+	ret._size = limbs::gcd(ret._limbs, a._limbs, a._size, b._limbs, b._size);
+	return ret;
+}
+
+BigInt util::lcm(const BigInt& a, const BigInt& b) {
+	if (a.isNaN() || b.isNaN()) return BigInt();
+	if (a._size == 0 || b._size == 0) return BigInt(0);
+	BigInt ret = a / gcd(a, b) * b;
+	ret._sign = true;
+	return ret;
+}
+
+std::tuple<BigInt, BigInt, BigInt> util::extended_gcd(const BigInt& a, const BigInt& b) {
+	if (a.isNaN() || b.isNaN()) return { BigInt(), BigInt(), BigInt() };
+	std::pmr::memory_resource* resource = BigInt::resultResource(a, b);
+	BigInt g(resource), x(resource), y(resource);
+	if (a._size == 0 || b._size == 0) {
+		//gcd(a, 0) = a * sgn(a)
+		g = a._size == 0 ? b : a;
+		g._sign = true;
+		x.assign(a._size != 0, a._sign);
+		y.assign(a._size == 0 && b._size != 0, b._sign);
+		return { std::move(g), std::move(x), std::move(y) };
+	}
+	g.reserve(std::min(a._size, b._size));
+	x.reserve(b._size);
+	uint32_t xn;
+	bool x_negative;
+	g._size = limbs::gcdext(g._limbs, x._limbs, xn, x_negative, a._limbs, a._size, b._limbs, b._size);
+	x._size = xn;
+	//|a| * x + |b| * y = g
+	x._sign = x_negative != a._sign;
+	x.normalize();
+	//把x约简到(-m / 2, m / 2]，m = |b| / g，再由x求出y
+	BigInt m = b / g;
+	m._sign = true;
+	x %= m;
+	if (!x._sign) x += m;
+	if (x + x > m) x -= m;
+	y = (g - a * x) / b;
+	return { std::move(g), std::move(x), std::move(y) };
+}
+
+BigInt util::mod_inverse(const BigInt& a, const BigInt& m) {
+	if (a.isNaN() || m.isNaN()) return BigInt();
+	if (m._size == 0 || !m._sign) throw std::domain_error("modulus must be positive");
+	BigInt r = a % m;
+	if (!r._sign) r += m;
+	if (m._size == 1 && m._limbs[0] == 1) return r;
+	if (r._size == 0) throw std::domain_error("not invertible");
+	BigInt g(m._resource), x(m._resource);
+	g.reserve(std::min(r._size, m._size));
+	x.reserve(m._size);
+	uint32_t xn;
+	bool x_negative;
+	g._size = limbs::gcdext(g._limbs, x._limbs, xn, x_negative, r._limbs, r._size, m._limbs, m._size);
+	if (g._size != 1 || g._limbs[0] != 1) throw std::domain_error("not invertible");
+	//|x| <= m
+	x._size = xn;
+	x._sign = !x_negative;
+	if (!x._sign) x += m;
+	return x;
+}
+
+BigInt util::isqrt(const BigInt& x) {
+	return iroot(x, 2);
+}
+
+BigInt util::iroot(const BigInt& x, uint32_t n) {
+	if (n == 0) throw std::domain_error("zeroth root");
+	if (x.isNaN()) return BigInt();
+	if (!x._sign && n % 2 == 0) throw std::domain_error("even root of negative number");
+	BigInt ret(x._resource);
+	if (x._size == 0) {
+		ret.assign(0, true);
+		return ret;
+	}
+	ret.reserve((x._size + n - 1) / n);
+	ret._size = limbs::iroot(ret._limbs, x._limbs, x._size, n);
+	ret._sign = x._sign;
+	return ret;
+}
+
+bool util::is_perfect_square(const BigInt& x) {
+	return !x.isNaN() && x._sign && limbs::isPerfectSquare(x._limbs, x._size);
+}
+
+bool util::is_perfect_power(const BigInt& x) {
+	if (x.isNaN()) return false;
+	if (x._size == 0) return true;
+	return limbs::isPerfectPower(x._limbs, x._size, !x._sign);
+}
+
+uint64_t util::bit_length(const BigInt& x) {
+	if (x.isNaN() || x._size == 0) return 0;
+	return uint64_t(x._size) * limbs::limb_bits - limbs::countLeadingZeros(x._limbs[x._size - 1]);
+}
+
+uint64_t util::popcount(const BigInt& x) {
+	if (x.isNaN()) return 0;
+	uint64_t ret{ 0 };
+	for (uint32_t i = 0; i < x._size; ++i) ret += limbs::popCount(x._limbs[i]);
+	return ret;
+}
+
+uint64_t util::count_trailing_zeros(const BigInt& x) {
+	if (x.isNaN() || x._size == 0) return 0;
+	uint32_t i{ 0 };
+	while (x._limbs[i] == 0) ++i;
+	return uint64_t(i) * limbs::limb_bits + limbs::countTrailingZeros(x._limbs[i]);
+}
+
+bool util::test_bit(const BigInt& x, uint64_t i) {
+	if (x.isNaN()) return false;
+	uint64_t word = i / limbs::limb_bits;
+	bool bit = word < x._size && ((x._limbs[word] >> (i % limbs::limb_bits)) & 1);
+	if (x._sign) return bit;
+	//~(|x| - 1)：最低的1以下都是0，最低的1不变，更高的位取反
+	uint64_t lowest = count_trailing_zeros(x);
+	return i == lowest || (i > lowest && !bit);
+}
+
+void util::set_bit(BigInt& x, uint64_t i, bool value) {
+	if (x.isNaN()) return;
+	if (!x._sign) {
+		//~x = |x| - 1非负，在它上面设置相反的值
+		x = ~x;
+		set_bit(x, i, !value);
+		x = ~x;
+		return;
+	}
+	uint64_t word = i / limbs::limb_bits;
+	BigInt::limb_t mask = BigInt::limb_t(1) << (i % limbs::limb_bits);
+	if (!value) {
+		if (word < x._size) {
+			x._limbs[word] &= ~mask;
+			x.normalize();
+		}
+		return;
+	}
+	if (word >= std::numeric_limits<uint32_t>::max()) throw std::overflow_error("BigInt too large");
+	if (word >= x._size) {
+		x.reserve(static_cast<uint32_t>(word) + 1);
+		std::fill(x._limbs + x._size, x._limbs + word + 1, 0);
+		x._size = static_cast<uint32_t>(word) + 1;
+	}
+	x._limbs[word] |= mask;
+}
+
+uint64_t util::heap_allocations() {
+	return BigInt::allocations();
+}
+
+limbs::MulThresholds util::mul_thresholds() {
+	return limbs::mulThresholds();
+}
+
+void util::set_mul_thresholds(const limbs::MulThresholds& thresholds) {
+	limbs::setMulThresholds(thresholds);
+}
+
+limbs::MulThresholds util::tune_multiplication() {
+	return limbs::tuneMulThresholds();
+}
+
+limbs::ParallelConfig util::parallel_config() {
+	return limbs::parallelConfig();
+}
+
+void util::set_parallel_config(const limbs::ParallelConfig& config) {
+	limbs::setParallelConfig(config);
 }
\ No newline at end of file
@@ -1,9 +1,84 @@
 #pragma once
 #include<src/BigInt_impl.h>
+#include<src/Limbs.h>
+#include<utility>
+#include<tuple>
+#include<optional>
+#include<charconv>
+#include<limits>
 
 class util {
 public:
 	static bool sign(const BigInt& bInt);
 	static uint32_t digits10(const BigInt& bInt);
-	static std::string to_string(const BigInt& bInt);
+	//2 <= base <= 36，大于10的数字用小写字母，2的幂进制线性转换，其它进制分治转换
+	static std::string to_string(const BigInt& bInt, int base = 10);
+	//整个字符串都是合法数字时返回对应的值，否则返回NaN，大小写字母都接受
+	static BigInt from_string(const std::string_view& str, int base = 10);
+	//直接写入调用者的缓冲区，不需要临时空间；数字恰好放得下时也能成功
+	//空间不足返回errc::value_too_large(缓冲区内容不确定)，NaN或base不合法返回errc::invalid_argument
+	static std::to_chars_result to_chars(char* first, char* last, const BigInt& bInt, int base = 10);
+	//解析开头的整数，没有数字时返回errc::invalid_argument且不修改bInt
+	static std::from_chars_result from_chars(const char* first, const char* last, BigInt& bInt, int base = 10);
+	//直接从limb转换到整数，超出范围或NaN时返回std::nullopt
+	template<typename Int, typename std::enable_if_t<std::is_integral_v<Int>, bool> = true>
+	static std::optional<Int> try_convert(const BigInt& bInt) {
+		Int ret;
+		if (!bInt.convert(ret)) return std::nullopt;
+		return ret;
+	}
+	//一次除法同时得到商和余数，商向0取整，余数与被除数同号
+	static std::pair<BigInt, BigInt> divmod(const BigInt& l, const BigInt& r);
+	//除数是机器字时余数直接以整数返回
+	static std::pair<BigInt, long long> divmod(const BigInt& l, long long r);
+	//无符号的除数可能超过long long，带被除数符号的余数也不一定放得进机器字，余数以BigInt返回
+	//不超过long long的除数仍然走机器字的路径；没有这个重载时会静默转换成long long而得到错误的结果
+	template<typename UInt, typename std::enable_if_t<std::is_integral_v<UInt> && std::is_unsigned_v<UInt> && !std::is_same_v<UInt, bool>, bool> = true>
+	static std::pair<BigInt, BigInt> divmod(const BigInt& l, UInt r) {
+		if (l.isNaN()) return { BigInt(), BigInt() };
+		if (static_cast<unsigned long long>(r) > static_cast<unsigned long long>(std::numeric_limits<long long>::max())) return divmod(l, BigInt(r));
+		auto [q, rem] = divmod(l, static_cast<long long>(r));
+		return { std::move(q), BigInt(rem) };
+	}
+	//x * x，只做一次变换，basecase利用交叉项的对称性；x * x本身也会走同样的路径
+	static BigInt square(const BigInt& x);
+	//从高位到低位的二进制快速幂，结果的空间一次分配好，放得进对象内部时不分配；底数是2的幂时直接移位
+	static BigInt pow(const BigInt& base, uint64_t exp);
+	//base^exp mod m，结果在[0, m)内；同一个模数反复使用时直接构造Modulus更快
+	static BigInt powmod(const BigInt& base, const BigInt& exp, const BigInt& m);
+	//最大公约数，结果非负，gcd(0, 0) = 0；Lehmer算法，很长时用half-gcd
+	static BigInt gcd(const BigInt& a, const BigInt& b);
+	//最小公倍数，结果非负，有一个为0时结果为0
+	static BigInt lcm(const BigInt& a, const BigInt& b);
+	//返回(g, x, y)，a * x + b * y = g = gcd(a, b)，b != 0时-|b| / 2g < x <= |b| / 2g
+	static std::tuple<BigInt, BigInt, BigInt> extended_gcd(const BigInt& a, const BigInt& b);
+	//a在模m下的逆元，结果在[0, m)内；m不为正或a与m不互素时抛出std::domain_error
+	static BigInt mod_inverse(const BigInt& a, const BigInt& m);
+	//floor(sqrt(x))，x < 0时抛出std::domain_error
+	static BigInt isqrt(const BigInt& x);
+	//n次方根，向0取整；n == 0，或x < 0且n为偶数时抛出std::domain_error
+	static BigInt iroot(const BigInt& x, uint32_t n);
+	static bool is_perfect_square(const BigInt& x);
+	//是否存在整数y和k >= 2使y^k = x，0, 1, -1都算；NaN返回false
+	static bool is_perfect_power(const BigInt& x);
+	//|x|的二进制位数，0和NaN为0
+	static uint64_t bit_length(const BigInt& x);
+	//|x|中1的个数
+	static uint64_t popcount(const BigInt& x);
+	//最低的1的位置，负数的补码与绝对值相同；0和NaN返回0
+	static uint64_t count_trailing_zeros(const BigInt& x);
+	//按二进制补码取第i位，负数的高位都是1
+	static bool test_bit(const BigInt& x, uint64_t i);
+	//按二进制补码把第i位设为value，NaN不变
+	static void set_bit(BigInt& x, uint64_t i, bool value = true);
+	//BigInt存储累计发生的堆分配次数
+	static uint64_t heap_allocations();
+	//乘法在basecase, karatsuba, toom-3, fft/ntt之间切换的阈值
+	static limbs::MulThresholds mul_thresholds();
+	static void set_mul_thresholds(const limbs::MulThresholds& thresholds);
+	//在当前机器上实测交叉点并应用，返回新的阈值
+	static limbs::MulThresholds tune_multiplication();
+	//并行乘法(以及基于乘法的大除法)的线程数和启用阈值，默认单线程
+	static limbs::ParallelConfig parallel_config();
+	static void set_parallel_config(const limbs::ParallelConfig& config);
 };
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+#include<include/BigInt.h>
+#include<cstdint>
+#include<random>
+#include<string>
+#include<vector>
+#include<type_traits>
+
+//很小的测试框架：TEST定义并注册用例，CHECK失败时记下位置后继续执行
+namespace test {
+	using Case = void(*)();
+	bool registerCase(const char* name, Case run);
+	void fail(const char* file, int line, const std::string& message);
+
+	//全局operator new被调用的次数，util::heap_allocations只统计BigInt自己的存储
+	uint64_t allocations();
+
+	//固定种子，失败可以复现
+	std::mt19937_64& rng();
+	//不超过bits位的随机数，signed_时随机取符号
+	//约一半的数由整段的0和全1的limb拼成，用来触发进位、借位和规范化的边界
+	BigInt random(uint64_t bits, bool signed_ = false);
+	//恰好bits位的随机正数
+	BigInt randomExact(uint64_t bits);
+	//恰好n个limb(最高位不为0)的随机数组，同样混有整段的0和全1
+	std::vector<limbs::limb_t> randomLimbs(uint32_t n);
+
+	inline std::string describe(const BigInt& x) {
+		return x.isNaN() ? std::string("NaN") : util::to_string(x);
+	}
+	inline std::string describe(const std::string& x) {
+		return '"' + x + '"';
+	}
+	inline std::string describe(const char* x) {
+		return describe(std::string(x));
+	}
+	inline std::string describe(bool x) {
+		return x ? "true" : "false";
+	}
+	//limb数组只输出长度和最低的几个limb
+	inline std::string describe(const std::vector<limbs::limb_t>& x) {
+		std::string ret = std::to_string(x.size()) + " limbs:";
+		for (size_t i = 0; i < x.size() && i < 4; ++i) ret += " " + std::to_string(x[i]);
+		return ret;
+	}
+	template<typename T, typename std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+	std::string describe(T x) {
+		return std::to_string(x);
+	}
+}
+
+#define TEST(name) \
+	static void name(); \
+	static const bool name##_registered = test::registerCase(#name, name); \
+	static void name()
+
+#define CHECK(cond) \
+	do { \
+		if (!(cond)) test::fail(__FILE__, __LINE__, #cond); \
+	} while (0)
+
+//a, b只求值一次，失败时输出两边的值
+#define CHECK_EQ(a, b) \
+	do { \
+		auto&& check_l_ = (a); \
+		auto&& check_r_ = (b); \
+		if (!(check_l_ == check_r_)) test::fail(__FILE__, __LINE__, #a " == " #b ": " + test::describe(check_l_) + " vs " + test::describe(check_r_)); \
+	} while (0)
+
+#define CHECK_THROWS(expr, type) \
+	do { \
+		bool check_thrown_{ false }; \
+		try { (void)(expr); } \
+		catch (const type&) { check_thrown_ = true; } \
+		if (!check_thrown_) test::fail(__FILE__, __LINE__, #expr " should throw " #type); \
+	} while (0)
@@ -0,0 +1,102 @@
+#include<memory_resource>
+#include<utility>
+#include<vector>
+
+#include"test/Test.h"
+
+//统计分配次数的资源，确认limb确实从这里分配
+class CountingResource : public std::pmr::memory_resource {
+public:
+	size_t allocations{ 0 };
+	size_t live{ 0 };
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		++allocations;
+		++live;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+	void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+		--live;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+};
+
+TEST(resourcePropagatesThroughResults) {
+	CountingResource counting;
+	{
+		const BigInt big = test::randomExact(2000);
+		BigInt a(big, &counting);
+		CHECK(a.resource() == &counting);
+		CHECK(BigInt(7).resource() == std::pmr::new_delete_resource());
+		uint64_t before = util::heap_allocations();
+		BigInt sum = a + big, prod = a * big, quo = a / 3, neg = -static_cast<const BigInt&>(a);
+		//左操作数使用全局new/delete时使用右操作数的资源
+		BigInt rsum = big + a;
+		CHECK_EQ(util::heap_allocations(), before);
+		CHECK(sum.resource() == &counting && prod.resource() == &counting && quo.resource() == &counting);
+		CHECK(neg.resource() == &counting && rsum.resource() == &counting);
+		CHECK_EQ(prod, big * big);
+		CHECK_EQ(neg, BigInt(0) - big);
+		CHECK(counting.allocations >= 6);
+	}
+	CHECK_EQ(counting.live, 0u);
+}
+
+//拷贝使用默认资源，移动保留资源，赋值保留目标的资源
+TEST(copyUsesDefaultResource) {
+	CountingResource counting, other;
+	const BigInt big = test::randomExact(1000);
+	BigInt a(big, &counting);
+	BigInt copy(a);
+	CHECK(copy.resource() == std::pmr::new_delete_resource());
+	CHECK_EQ(copy, a);
+	BigInt explicit_copy(a, a.resource());
+	CHECK(explicit_copy.resource() == &counting);
+	BigInt moved(std::move(explicit_copy));
+	CHECK(moved.resource() == &counting);
+	CHECK_EQ(moved, big);
+
+	std::pmr::memory_resource* previous = std::pmr::set_default_resource(&other);
+	BigInt copy2(a);
+	std::pmr::set_default_resource(previous);
+	CHECK(copy2.resource() == &other);
+	CHECK(other.allocations == 1);
+
+	BigInt target(&other);
+	target = a;
+	CHECK(target.resource() == &other);
+	target = std::move(moved);
+	CHECK(target.resource() == &other);
+	CHECK_EQ(target, big);
+	//资源相同时移动赋值直接接管缓冲区
+	BigInt same(&counting);
+	size_t allocations = counting.allocations;
+	same = std::move(a);
+	CHECK_EQ(counting.allocations, allocations);
+	CHECK_EQ(same, big);
+}
+
+TEST(arenaReusesMemory) {
+	char buffer[4096];
+	BigIntArena arena(buffer, sizeof(buffer));
+	const BigInt x = test::randomExact(3000), y = test::randomExact(2500);
+	uint64_t before = util::heap_allocations();
+	{
+		BigInt acc(&arena);
+		acc = 0;
+		for (int i = 0; i < 200; ++i) {
+			BigInt term = BigInt(x, &arena) * y + i;
+			acc += term;
+			acc %= x;
+		}
+		CHECK_EQ(acc, BigInt(199 * 200 / 2));
+		CHECK(acc.resource() == &arena);
+	}
+	CHECK_EQ(util::heap_allocations(), before);
+	arena.release();
+	BigInt after(y, &arena);
+	CHECK_EQ(after, y);
+}
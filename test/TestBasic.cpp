@@ -0,0 +1,85 @@
+#include<string>
+#include<limits>
+#include<cmath>
+
+#include"test/Test.h"
+
+TEST(constructFromIntegers) {
+	CHECK_EQ(util::to_string(BigInt(0)), "0");
+	CHECK_EQ(util::to_string(BigInt(-1)), "-1");
+	CHECK_EQ(util::to_string(BigInt(4294967295u)), "4294967295");
+	CHECK_EQ(util::to_string(BigInt(4294967296ull)), "4294967296");
+	CHECK_EQ(util::to_string(BigInt(std::numeric_limits<unsigned long long>::max())), "18446744073709551615");
+	CHECK_EQ(util::to_string(BigInt(std::numeric_limits<long long>::min())), "-9223372036854775808");
+	CHECK_EQ(util::to_string(BigInt(std::numeric_limits<long long>::max())), "9223372036854775807");
+}
+
+TEST(constructFromDoubles) {
+	CHECK_EQ(util::to_string(BigInt(3.1415926)), "3");
+	CHECK_EQ(util::to_string(BigInt(-2.9)), "-2");
+	CHECK_EQ(util::to_string(BigInt(-0.5)), "0");
+	CHECK_EQ(util::to_string(BigInt(1e30)), "1000000000000000019884624838656");
+	CHECK_EQ(util::to_string(BigInt(-18446744073709551616.0)), "-18446744073709551616");
+	CHECK(BigInt(std::nan("")).isNaN());
+	CHECK(BigInt(std::numeric_limits<double>::infinity()).isNaN());
+}
+
+TEST(constructFromStrings) {
+	std::string s = "-123456789012345678901234567890";
+	CHECK_EQ(util::to_string(BigInt(s)), s);
+	CHECK_EQ(util::to_string(BigInt("000123")), "123");
+	CHECK_EQ(util::to_string(BigInt("-0")), "0");
+	CHECK(BigInt("").isNaN());
+	CHECK(BigInt("-").isNaN());
+	CHECK(BigInt("12a").isNaN());
+	CHECK(BigInt("+1").isNaN());
+}
+
+TEST(stringRoundTrip) {
+	for (int i = 0; i < 200; ++i) {
+		BigInt x = test::random(2000, true);
+		CHECK_EQ(BigInt(util::to_string(x)), x);
+	}
+}
+
+TEST(addSubCarryAndBorrow) {
+	BigInt max32(4294967295u), max64(std::numeric_limits<unsigned long long>::max());
+	CHECK_EQ(util::to_string(max32 + 1), "4294967296");
+	CHECK_EQ(util::to_string(max64 + 1), "18446744073709551616");
+	CHECK_EQ(max64 + 1 - 1, max64);
+	CHECK_EQ(util::to_string(BigInt(0) - max64), "-18446744073709551615");
+	CHECK_EQ(util::to_string(BigInt(5) - 7), "-2");
+	CHECK_EQ(util::to_string(BigInt(-5) + 7), "2");
+	CHECK_EQ(util::to_string(BigInt(-5) - -5), "0");
+	//结果为0时符号总是正的
+	CHECK(util::sign(BigInt(-5) + 5));
+}
+
+TEST(addSubRandom) {
+	for (int i = 0; i < 500; ++i) {
+		BigInt a = test::random(1500, true), b = test::random(1500, true);
+		BigInt s = a + b, d = a - b;
+		CHECK_EQ(s - b, a);
+		CHECK_EQ(d + b, a);
+		CHECK_EQ(s + d, a + a);
+		CHECK_EQ(a - a, BigInt(0));
+	}
+}
+
+TEST(nanPropagates) {
+	BigInt nan, one(1);
+	CHECK(nan.isNaN());
+	CHECK((nan + one).isNaN());
+	CHECK((one - nan).isNaN());
+	CHECK((nan * one).isNaN());
+	CHECK((one / nan).isNaN());
+	CHECK((-nan).isNaN());
+	CHECK(!(nan == nan));
+	CHECK(nan != nan);
+	CHECK_EQ(util::to_string(nan), "");
+}
+
+TEST(divisionByZeroThrows) {
+	CHECK_THROWS(BigInt(1) / BigInt(0), std::domain_error);
+	CHECK_THROWS(BigInt(1) % BigInt(0), std::domain_error);
+}
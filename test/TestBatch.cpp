@@ -0,0 +1,111 @@
+#include<vector>
+#include<thread>
+#include<atomic>
+#include<memory_resource>
+
+#include"test/Test.h"
+
+static std::vector<BigInt> randomVector(size_t n, uint64_t bits) {
+	std::vector<BigInt> ret;
+	for (size_t i = 0; i < n; ++i) ret.push_back(i % 97 == 5 ? BigInt() : test::random(bits, true));
+	return ret;
+}
+
+static bool sameOrBothNaN(const BigInt& a, const BigInt& b) {
+	return a.isNaN() ? b.isNaN() : a == b;
+}
+
+//分别在串行和并行模式下与逐个运算的结果对照，包括NaN和out就是输入的情况
+TEST(batchMatchesElementwise) {
+	const limbs::ParallelConfig saved = util::parallel_config();
+	for (uint32_t threads : { 1u, 4u }) {
+		util::set_parallel_config({ threads, saved.threshold });
+		const size_t n = 1500;
+		std::vector<BigInt> l = randomVector(n, 600), r = randomVector(n, 400), out(n);
+		batch::add(l.data(), r.data(), out.data(), n);
+		for (size_t i = 0; i < n; ++i) CHECK(sameOrBothNaN(out[i], l[i] + r[i]));
+		batch::sub(l.data(), r.data(), out.data(), n);
+		for (size_t i = 0; i < n; ++i) CHECK(sameOrBothNaN(out[i], l[i] - r[i]));
+		batch::mul(l.data(), r.data(), out.data(), n);
+		for (size_t i = 0; i < n; ++i) CHECK(sameOrBothNaN(out[i], l[i] * r[i]));
+		batch::mul_scalar(l.data(), BigInt(-7), out.data(), n);
+		for (size_t i = 0; i < n; ++i) CHECK(sameOrBothNaN(out[i], l[i] * -7));
+		std::vector<int> cmp(n);
+		batch::compare(l.data(), r.data(), cmp.data(), n);
+		for (size_t i = 0; i < n; ++i) CHECK_EQ(cmp[i], l[i].compare(r[i]));
+		//原地运算
+		std::vector<BigInt> acc = l;
+		batch::mul(acc.data(), r.data(), acc.data(), n);
+		batch::add(acc.data(), acc.data(), acc.data(), n);
+		for (size_t i = 0; i < n; ++i) CHECK(sameOrBothNaN(acc[i], l[i] * r[i] * 2));
+		batch::mul_scalar(acc.data(), acc[3], acc.data(), n);
+	}
+	util::set_parallel_config(saved);
+}
+
+TEST(batchSumAndProduct) {
+	const limbs::ParallelConfig saved = util::parallel_config();
+	std::vector<BigInt> v;
+	for (int i = 0; i < 1200; ++i) v.push_back(test::random(300, true));
+	BigInt sum(0), product(1);
+	for (const BigInt& x : v) {
+		sum += x;
+		product *= x;
+	}
+	for (uint32_t threads : { 1u, 3u }) {
+		util::set_parallel_config({ threads, saved.threshold });
+		CHECK_EQ(batch::sum(v.data(), v.size()), sum);
+		CHECK_EQ(batch::product(v.data(), v.size()), product);
+		CHECK_EQ(batch::sum(v.data(), 0), BigInt(0));
+		CHECK_EQ(batch::product(v.data(), 0), BigInt(1));
+		CHECK_EQ(batch::product(v.data(), 1), v[0]);
+		std::vector<BigInt> with_nan = v;
+		with_nan[700] = BigInt();
+		CHECK(batch::sum(with_nan.data(), with_nan.size()).isNaN());
+	}
+	util::set_parallel_config(saved);
+}
+
+//记录分配和释放发生在哪个线程，不是线程安全的资源只能在调用线程上使用
+class SingleThreadResource : public std::pmr::memory_resource {
+public:
+	std::thread::id owner{ std::this_thread::get_id() };
+	std::atomic<int> foreign{ 0 };
+private:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		if (std::this_thread::get_id() != owner) ++foreign;
+		return _pool.allocate(bytes, alignment);
+	}
+	void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+		if (std::this_thread::get_id() != owner) ++foreign;
+		_pool.deallocate(p, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+	std::pmr::unsynchronized_pool_resource _pool;
+};
+
+TEST(batchOutputsFromArenaStayOnCallingThread) {
+	const limbs::ParallelConfig saved = util::parallel_config();
+	util::set_parallel_config({ 4, saved.threshold });
+	SingleThreadResource resource;
+	{
+		const size_t n = 2000;
+		std::vector<BigInt> l = randomVector(n, 900), r = randomVector(n, 700), out;
+		//BigInt的移动构造不是noexcept，扩容时vector会拷贝，拷贝使用默认资源
+		out.reserve(n);
+		for (size_t i = 0; i < n; ++i) out.emplace_back(i % 3 ? BigInt(i) : test::random(2000), &resource);
+		batch::add(l.data(), r.data(), out.data(), n);
+		batch::mul(l.data(), r.data(), out.data(), n);
+		for (size_t i = 0; i < n; ++i) CHECK(sameOrBothNaN(out[i], l[i] * r[i]));
+		//输出同时也是输入
+		batch::mul(out.data(), r.data(), out.data(), n);
+		batch::sub(out.data(), l.data(), out.data(), n);
+		batch::mul_scalar(out.data(), BigInt(1) << 100, out.data(), n);
+		for (size_t i = 0; i < n; ++i) CHECK(sameOrBothNaN(out[i], (l[i] * r[i] * r[i] - l[i]) << 100));
+		CHECK(out[1].resource() == &resource);
+	}
+	CHECK_EQ(resource.foreign.load(), 0);
+	util::set_parallel_config(saved);
+}
@@ -0,0 +1,154 @@
+#include<cstdint>
+
+#include"test/Test.h"
+
+namespace {
+	//floor(x / 2^k)
+	BigInt floorShift(const BigInt& x, uint64_t k) {
+		BigInt d = BigInt(1) << k;
+		auto [q, r] = util::divmod(x, d);
+		if (r < 0) q -= 1;
+		return q;
+	}
+
+	int64_t randomSmall() {
+		int64_t x = static_cast<int64_t>(test::rng()() >> (2 + test::rng()() % 60));
+		return test::rng()() & 1 ? -x : x;
+	}
+}
+
+//不超过62位时与int64_t的补码运算逐个比较
+TEST(bitwiseMatchesInt64) {
+	for (int i = 0; i < 2000; ++i) {
+		int64_t a = randomSmall(), b = randomSmall();
+		BigInt x(a), y(b);
+		CHECK_EQ(x & y, BigInt(a & b));
+		CHECK_EQ(x | y, BigInt(a | b));
+		CHECK_EQ(x ^ y, BigInt(a ^ b));
+		CHECK_EQ(~static_cast<const BigInt&>(x), BigInt(~a));
+		uint32_t k = test::rng()() % 62;
+		CHECK_EQ(x >> k, floorShift(x, k));
+		for (uint32_t j = 0; j < 64; ++j) CHECK_EQ(util::test_bit(x, j), ((uint64_t(a) >> j) & 1) != 0);
+	}
+	CHECK_EQ(BigInt(-1) >> 100, BigInt(-1));
+	CHECK_EQ(BigInt(-5) >> 1, BigInt(-3));
+	CHECK_EQ(BigInt(-4) >> 2, BigInt(-1));
+	CHECK_EQ(BigInt(5) >> 3, BigInt(0));
+	CHECK_EQ(BigInt(-5) >> 3, BigInt(-1));
+}
+
+//长的操作数用恒等式核对，符号不同、长度不同、跨limb的移位都要覆盖
+TEST(bitwiseIdentities) {
+	for (int i = 0; i < 200; ++i) {
+		BigInt x = test::random(1 + test::rng()() % 2000, true), y = test::random(1 + test::rng()() % 2000, true);
+		const BigInt& cx = x;
+		CHECK_EQ(~cx, BigInt(0) - x - BigInt(1));
+		CHECK_EQ(~~cx, x);
+		CHECK_EQ((x & y) + (x | y), x + y);
+		CHECK_EQ(x ^ y, (x | y) - (x & y));
+		CHECK_EQ(~(x & y), ~cx | ~static_cast<const BigInt&>(y));
+		CHECK_EQ(x & BigInt(0), BigInt(0));
+		CHECK_EQ(x | BigInt(-1), BigInt(-1));
+		CHECK_EQ(x ^ x, BigInt(0));
+		uint64_t k = test::rng()() % 300;
+		CHECK_EQ(x << k, x * (BigInt(1) << k));
+		CHECK_EQ(x >> k, floorShift(x, k));
+		CHECK_EQ((x << k) >> k, x);
+		for (int j = 0; j < 20; ++j) {
+			uint64_t bit = test::rng()() % 2200;
+			bool bx = util::test_bit(x, bit), by = util::test_bit(y, bit);
+			CHECK_EQ(util::test_bit(x & y, bit), bx && by);
+			CHECK_EQ(util::test_bit(x | y, bit), bx || by);
+			CHECK_EQ(util::test_bit(x ^ y, bit), bx != by);
+			CHECK_EQ(util::test_bit(x >> k, bit), util::test_bit(x, bit + k));
+		}
+	}
+}
+
+TEST(bitwiseCompoundAndNaN) {
+	for (int i = 0; i < 100; ++i) {
+		BigInt x = test::random(700, true), y = test::random(300, true);
+		BigInt a = x, o = x, e = x, l = x, r = x;
+		a &= y;
+		o |= y;
+		e ^= y;
+		l <<= 77;
+		r >>= 77;
+		CHECK_EQ(a, x & y);
+		CHECK_EQ(o, x | y);
+		CHECK_EQ(e, x ^ y);
+		CHECK_EQ(l, x << 77);
+		CHECK_EQ(r, x >> 77);
+		BigInt s = x;
+		s &= s;
+		CHECK_EQ(s, x);
+		s ^= s;
+		CHECK_EQ(s, BigInt(0));
+	}
+	BigInt nan;
+	CHECK((nan & BigInt(1)).isNaN());
+	CHECK((BigInt(1) | nan).isNaN());
+	CHECK((nan ^ nan).isNaN());
+	CHECK((~static_cast<const BigInt&>(nan)).isNaN());
+	CHECK((nan << 3).isNaN());
+	CHECK((nan >> 3).isNaN());
+	CHECK(!util::test_bit(nan, 0));
+}
+
+//负数按补码读写，高位都是1
+TEST(testAndSetBit) {
+	for (int i = 0; i < 300; ++i) {
+		BigInt x = test::random(1 + test::rng()() % 500, true);
+		uint64_t bit = test::rng()() % 600;
+		bool value = test::rng()() & 1;
+		BigInt expected = value ? x | (BigInt(1) << bit) : x & ~(BigInt(1) << bit);
+		BigInt y = x;
+		util::set_bit(y, bit, value);
+		CHECK_EQ(y, expected);
+		CHECK_EQ(util::test_bit(y, bit), value);
+		CHECK_EQ(util::test_bit(y, bit + 1), util::test_bit(x, bit + 1));
+	}
+	CHECK(util::test_bit(BigInt(-1), 100000));
+	CHECK(!util::test_bit(BigInt(1), 100000));
+	CHECK(!util::test_bit(BigInt(-4), 1));
+	CHECK(util::test_bit(BigInt(-4), 2));
+	BigInt x(-1);
+	util::set_bit(x, 64, false);
+	CHECK_EQ(x, BigInt(-1) - (BigInt(1) << 64));
+	BigInt z(0);
+	util::set_bit(z, 200);
+	CHECK_EQ(z, BigInt(1) << 200);
+	util::set_bit(z, 200, false);
+	CHECK_EQ(z, BigInt(0));
+	BigInt nan;
+	util::set_bit(nan, 3);
+	CHECK(nan.isNaN());
+}
+
+//按绝对值计算
+TEST(bitQueries) {
+	for (int i = 0; i < 200; ++i) {
+		BigInt x = test::random(1 + test::rng()() % 3000, true);
+		BigInt m = x < 0 ? BigInt(0) - x : x;
+		uint64_t len{ 0 }, ones{ 0 };
+		for (uint64_t j = 0; j < 3000; ++j) {
+			if (util::test_bit(m, j)) {
+				len = j + 1;
+				++ones;
+			}
+		}
+		CHECK_EQ(util::bit_length(x), len);
+		CHECK_EQ(util::popcount(x), ones);
+		if (m != 0) {
+			uint64_t tz = util::count_trailing_zeros(x);
+			CHECK(util::test_bit(m, tz));
+			CHECK_EQ(m >> tz << tz, m);
+		}
+	}
+	CHECK_EQ(util::bit_length(BigInt(0)), uint64_t(0));
+	CHECK_EQ(util::bit_length(BigInt(-8)), uint64_t(4));
+	CHECK_EQ(util::popcount(BigInt(-7)), uint64_t(3));
+	CHECK_EQ(util::count_trailing_zeros(BigInt(-12)), uint64_t(2));
+	CHECK_EQ(util::count_trailing_zeros(BigInt(0)), uint64_t(0));
+	CHECK_EQ(util::bit_length(BigInt()), uint64_t(0));
+}
@@ -0,0 +1,62 @@
+#include<string>
+#include<vector>
+#include<charconv>
+
+#include"test/Test.h"
+
+//缓冲区恰好等于位数时成功，少一位时返回value_too_large
+static void checkExactBuffer(const BigInt& x, int base) {
+	std::string expected = util::to_string(x, base);
+	std::vector<char> buf(expected.size() + 1, '#');
+	auto [end, ec] = util::to_chars(buf.data(), buf.data() + expected.size(), x, base);
+	CHECK(ec == std::errc());
+	CHECK_EQ(std::string(buf.data(), end), expected);
+	CHECK_EQ(buf[expected.size()], '#');
+	auto short_result = util::to_chars(buf.data(), buf.data() + expected.size() - 1, x, base);
+	CHECK(short_result.ec == std::errc::value_too_large);
+}
+
+//radix^k - 1和radix^k附近位数刚好变化
+TEST(toCharsAroundPowers) {
+	for (int base : { 2, 3, 7, 10, 16, 36 }) {
+		for (uint64_t k : { 1, 9, 10, 19, 20, 150, 400, 3000 }) {
+			BigInt p = util::pow(BigInt(base), k);
+			for (const BigInt& x : { p - 1, p, p + 1, BigInt(0) - p, BigInt(1) - p }) checkExactBuffer(x, base);
+		}
+	}
+	checkExactBuffer(BigInt(0), 10);
+	checkExactBuffer(BigInt(-1), 2);
+}
+
+TEST(toCharsRandom) {
+	for (int i = 0; i < 300; ++i) {
+		BigInt x = test::random(i < 280 ? 1500 : 40000, true);
+		checkExactBuffer(x, i % 35 + 2);
+	}
+}
+
+//缓冲区刚好放得下时不需要任何临时空间
+TEST(toCharsDoesNotAllocate) {
+	const BigInt x = test::randomExact(1000);
+	std::string expected = util::to_string(x);
+	std::vector<char> buf(expected.size());
+	char bin[1000];
+	uint64_t before = test::allocations();
+	auto [end, ec] = util::to_chars(buf.data(), buf.data() + buf.size(), x);
+	auto bin_result = util::to_chars(bin, bin + sizeof(bin), x, 2);
+	CHECK_EQ(test::allocations(), before);
+	CHECK(ec == std::errc() && bin_result.ec == std::errc());
+	CHECK_EQ(std::string(buf.data(), end), expected);
+	CHECK_EQ(std::string(bin, bin_result.ptr), util::to_string(x, 2));
+}
+
+TEST(toCharsErrors) {
+	char buf[8];
+	CHECK(util::to_chars(buf, buf + 8, BigInt()).ec == std::errc::invalid_argument);
+	CHECK(util::to_chars(buf, buf + 8, BigInt(1), 1).ec == std::errc::invalid_argument);
+	CHECK(util::to_chars(buf, buf + 8, BigInt(1), 37).ec == std::errc::invalid_argument);
+	CHECK(util::to_chars(buf, buf, BigInt(-1)).ec == std::errc::value_too_large);
+	CHECK(util::to_chars(buf, buf + 1, BigInt(-1)).ec == std::errc::value_too_large);
+	CHECK(util::to_chars(buf, buf, BigInt(0)).ec == std::errc::value_too_large);
+	CHECK_THROWS(util::to_string(BigInt(1), 40), std::invalid_argument);
+}
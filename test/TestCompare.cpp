@@ -0,0 +1,76 @@
+#include<vector>
+#include<algorithm>
+#include<limits>
+
+#include"test/Test.h"
+
+//与减法结果的符号对照
+TEST(compareRandom) {
+	for (int i = 0; i < 500; ++i) {
+		const BigInt a = test::random(700, true);
+		const BigInt b = i % 4 == 0 ? a + (i % 8 ? 1 : 0) : test::random(700, true);
+		BigInt d = a - b;
+		int expected = d == 0 ? 0 : (util::sign(d) ? 1 : -1);
+		CHECK_EQ(a.compare(b), expected);
+		CHECK_EQ(b.compare(a), -expected);
+		CHECK_EQ(a < b, expected < 0);
+		CHECK_EQ(a <= b, expected <= 0);
+		CHECK_EQ(a > b, expected > 0);
+		CHECK_EQ(a >= b, expected >= 0);
+		CHECK_EQ(a == b, expected == 0);
+		CHECK_EQ(a != b, expected != 0);
+	}
+}
+
+TEST(compareWithIntegers) {
+	const long long values[] = { 0, 1, -1, 2, 0xffffffffll, 0x100000000ll, -0x100000000ll,
+		std::numeric_limits<long long>::max(), std::numeric_limits<long long>::min() };
+	for (long long x : values) {
+		for (long long y : values) {
+			const BigInt bx(x);
+			CHECK_EQ(bx.compare(y), x < y ? -1 : (x > y ? 1 : 0));
+			CHECK_EQ(bx < y, x < y);
+			CHECK_EQ(y < bx, y < x);
+			CHECK_EQ(bx == y, x == y);
+			CHECK_EQ(y != bx, y != x);
+			CHECK_EQ(bx >= y, x >= y);
+			CHECK_EQ(y <= bx, y <= x);
+		}
+	}
+	const BigInt max64(std::numeric_limits<unsigned long long>::max());
+	CHECK_EQ(max64.compare(std::numeric_limits<unsigned long long>::max()), 0);
+	CHECK(max64 > std::numeric_limits<long long>::max());
+	CHECK(max64 + 1 > std::numeric_limits<unsigned long long>::max());
+	CHECK(BigInt(0) - max64 < std::numeric_limits<long long>::min());
+	CHECK(BigInt(-1) < 0u);
+	CHECK(BigInt(200) > static_cast<unsigned char>(100));
+	CHECK(BigInt(-5) == static_cast<short>(-5));
+}
+
+//compare把NaN排在最前面，关系运算符遇到NaN都为false
+TEST(compareNaN) {
+	const BigInt nan, one(1), neg = BigInt(0) - (BigInt(1) << 300);
+	CHECK_EQ(nan.compare(nan), 0);
+	CHECK_EQ(nan.compare(neg), -1);
+	CHECK_EQ(neg.compare(nan), 1);
+	CHECK_EQ(nan.compare(0), -1);
+	CHECK(!(nan < one) && !(nan > one) && !(nan <= one) && !(nan >= one) && !(nan == one));
+	CHECK(!(one < nan) && !(one >= nan));
+	CHECK(!(nan < 1) && !(nan == 0) && nan != 0 && !(0 > nan));
+#ifdef BIGINT_HAS_SPACESHIP
+	CHECK((nan <=> one) == std::partial_ordering::unordered);
+	CHECK((neg <=> one) == std::partial_ordering::less);
+	CHECK((one <=> BigInt(1)) == std::partial_ordering::equivalent);
+#endif
+}
+
+TEST(compareSortsTotally) {
+	std::vector<BigInt> v;
+	for (int i = 0; i < 300; ++i) v.push_back(test::random(300, true));
+	v.push_back(BigInt());
+	v.push_back(BigInt(0));
+	v.push_back(BigInt());
+	std::sort(v.begin(), v.end(), [](const BigInt& l, const BigInt& r) { return l.compare(r) < 0; });
+	CHECK(v[0].isNaN() && v[1].isNaN() && !v[2].isNaN());
+	for (size_t i = 3; i < v.size(); ++i) CHECK(v[i - 1] <= v[i]);
+}
@@ -0,0 +1,97 @@
+#include<utility>
+
+#include"test/Test.h"
+
+TEST(compoundMatchesBinary) {
+	for (int i = 0; i < 300; ++i) {
+		const BigInt a = test::random(1500, true), b = test::random(800, true);
+		BigInt x = a;
+		x += b;
+		CHECK_EQ(x, a + b);
+		x = a;
+		x -= b;
+		CHECK_EQ(x, a - b);
+		x = a;
+		x *= b;
+		CHECK_EQ(x, a * b);
+		if (b == 0) continue;
+		x = a;
+		x /= b;
+		CHECK_EQ(x, a / b);
+		x = a;
+		x %= b;
+		CHECK_EQ(x, a % b);
+	}
+}
+
+//左右操作数是同一个对象，扩容之后还要读到正确的limb
+TEST(compoundAliasing) {
+	for (int i = 0; i < 100; ++i) {
+		const BigInt a = test::random(1000, true);
+		BigInt x = a;
+		x += x;
+		CHECK_EQ(x, a * 2);
+		x = a;
+		x -= x;
+		CHECK_EQ(x, BigInt(0));
+		CHECK(util::sign(x));
+		x = a;
+		x *= x;
+		CHECK_EQ(x, a * a);
+		if (a == 0) continue;
+		x = a;
+		x /= x;
+		CHECK_EQ(x, BigInt(1));
+		x = a;
+		x %= x;
+		CHECK_EQ(x, BigInt(0));
+	}
+}
+
+TEST(compoundNaN) {
+	BigInt x(5);
+	x += BigInt();
+	CHECK(x.isNaN());
+	x = 5;
+	x *= BigInt();
+	CHECK(x.isNaN());
+	x -= 1;
+	CHECK(x.isNaN());
+	x = 5;
+	CHECK_THROWS(x /= 0, std::domain_error);
+}
+
+//容量按1.5倍增长，逐位变长的累加只分配对数次
+TEST(accumulatorGrowsGeometrically) {
+	BigInt acc(1);
+	uint64_t before = util::heap_allocations();
+	for (int i = 0; i < 4000; ++i) acc += acc;
+	CHECK(util::heap_allocations() - before < 16);
+	CHECK_EQ(acc, BigInt(1) << 4000);
+	BigInt counter(0);
+	for (int i = 0; i < 1000; ++i) ++counter;
+	for (int i = 0; i < 300; ++i) counter--;
+	CHECK_EQ(counter, BigInt(700));
+}
+
+//右值版本复用即将销毁的操作数的缓冲区
+TEST(rvalueOperatorsReuseBuffers) {
+	const BigInt small(12345);
+	//最高limb只用了低位，加倍不进位；扩容后留有余量
+	BigInt x = test::randomExact(3000);
+	const BigInt a = x;
+	x += x;
+	uint64_t before = util::heap_allocations();
+	BigInt y = std::move(x) + small;
+	BigInt z = small - std::move(y);
+	BigInt w = std::move(z) - small;
+	BigInt v = small + std::move(w);
+	BigInt u = std::move(v) + BigInt(1);
+	CHECK_EQ(util::heap_allocations(), before);
+	CHECK_EQ(u, BigInt(0) - a * 2 + 1);
+	CHECK_EQ(BigInt(7) - BigInt(10), BigInt(-3));
+	CHECK_EQ(small - (small + 1), BigInt(-1));
+	CHECK_EQ((small + 1) - (small + 2), BigInt(-1));
+	CHECK((BigInt() + BigInt(1)).isNaN());
+	CHECK((small - BigInt()).isNaN());
+}
@@ -0,0 +1,64 @@
+#include<limits>
+#include<cstdint>
+
+#include"test/Test.h"
+
+//在边界两侧各取一个值，范围内的转换要精确，范围外的try_convert返回nullopt
+template<typename Int>
+static void checkBounds() {
+	using limits = std::numeric_limits<Int>;
+	const BigInt lo(limits::min()), hi(limits::max());
+	CHECK(util::try_convert<Int>(lo) == limits::min());
+	CHECK(util::try_convert<Int>(hi) == limits::max());
+	CHECK(util::try_convert<Int>(BigInt(0)) == Int(0));
+	CHECK(!util::try_convert<Int>(hi + 1).has_value());
+	CHECK(!util::try_convert<Int>(lo - 1).has_value());
+	CHECK(!util::try_convert<Int>(BigInt()).has_value());
+	//显式转换超出范围时缩窄到最大值或最小值，NaN转换为0
+	CHECK(static_cast<Int>(hi + 1) == limits::max());
+	CHECK(static_cast<Int>(lo - 1) == limits::min());
+	CHECK(static_cast<Int>(hi << 100) == limits::max());
+	CHECK(static_cast<Int>(BigInt()) == 0);
+	CHECK(static_cast<Int>(hi) == limits::max());
+	CHECK(static_cast<Int>(lo) == limits::min());
+}
+
+TEST(convertBounds) {
+	checkBounds<long long>();
+	checkBounds<long>();
+	checkBounds<int>();
+	checkBounds<short>();
+	checkBounds<char>();
+	checkBounds<unsigned long long>();
+	checkBounds<unsigned long>();
+	checkBounds<unsigned int>();
+	checkBounds<unsigned short>();
+	checkBounds<unsigned char>();
+}
+
+TEST(convertRandom64) {
+	std::mt19937_64& r = test::rng();
+	for (int i = 0; i < 2000; ++i) {
+		long long x = static_cast<long long>(r() >> (r() % 64));
+		if (r() & 1) x = -x;
+		const BigInt b(x);
+		CHECK_EQ(static_cast<long long>(b), x);
+		CHECK_EQ(util::try_convert<int64_t>(b).value_or(0), x);
+		CHECK_EQ(util::try_convert<uint64_t>(b).has_value(), x >= 0);
+		CHECK_EQ(util::try_convert<int32_t>(b).has_value(), x >= INT32_MIN && x <= INT32_MAX);
+	}
+}
+
+//直接从limb转换，不经过字符串，也不分配内存
+TEST(convertDoesNotAllocate) {
+	const BigInt big = (BigInt(1) << 500) + 7, small(-123456789);
+	uint64_t before = util::heap_allocations();
+	long long a = static_cast<long long>(small);
+	long long b = static_cast<long long>(big);
+	auto c = util::try_convert<int>(big);
+	auto d = util::try_convert<unsigned>(small);
+	CHECK_EQ(util::heap_allocations(), before);
+	CHECK_EQ(a, -123456789ll);
+	CHECK_EQ(b, std::numeric_limits<long long>::max());
+	CHECK(!c && !d);
+}
@@ -0,0 +1,107 @@
+#include<vector>
+#include<algorithm>
+
+#include"test/Test.h"
+
+using Limbs = std::vector<limbs::limb_t>;
+using DivFunction = void(*)(limbs::limb_t*, limbs::limb_t*, const limbs::limb_t*, uint32_t, const limbs::limb_t*, uint32_t);
+
+//返回商和余数拼在一起的数组，便于整体比较
+static Limbs quotientAndRemainder(DivFunction f, const Limbs& a, const Limbs& b) {
+	uint32_t an = static_cast<uint32_t>(a.size()), bn = static_cast<uint32_t>(b.size());
+	Limbs ret(an + 1);
+	f(ret.data(), ret.data() + an - bn + 1, a.data(), an, b.data(), bn);
+	return ret;
+}
+
+//q * b + r == a且0 <= |r| < |b|，r与a同号
+static void checkDivision(const BigInt& a, const BigInt& b) {
+	BigInt q = a / b, r = a % b;
+	CHECK_EQ(q * b + r, a);
+	CHECK(r == 0 || util::sign(r) == util::sign(a));
+	BigInt abs_r = util::sign(r) ? r : BigInt(0) - r, abs_b = util::sign(b) ? b : BigInt(0) - b;
+	CHECK(abs_r < abs_b);
+}
+
+TEST(divisionSigns) {
+	//截断除法：商向0取整，余数与被除数同号
+	CHECK_EQ(BigInt(-7) / 2, BigInt(-3));
+	CHECK_EQ(BigInt(-7) % 2, BigInt(-1));
+	CHECK_EQ(BigInt(7) / -2, BigInt(-3));
+	CHECK_EQ(BigInt(7) % -2, BigInt(1));
+	CHECK_EQ(BigInt(-7) / -2, BigInt(3));
+	CHECK_EQ(BigInt(-7) % -2, BigInt(-1));
+	CHECK_EQ(BigInt(3) / 7, BigInt(0));
+	CHECK_EQ(BigInt(-3) % 7, BigInt(-3));
+	CHECK(util::sign(BigInt(-6) % 3));
+	CHECK(util::sign(BigInt(-1) / 2));
+}
+
+TEST(divisionRandom) {
+	for (int i = 0; i < 400; ++i) {
+		BigInt a = test::random(3000, true), b = test::random(1500, true);
+		if (b == 0) continue;
+		checkDivision(a, b);
+	}
+}
+
+//试商需要修正和加回的情况：除数最高limb刚好规范化，被除数的limb多为全1或0
+TEST(knuthCorrectionCases) {
+	const BigInt B = BigInt(1) << 32;
+	for (uint32_t bn = 2; bn < 12; ++bn) {
+		BigInt top = BigInt(1) << (32 * bn - 1);
+		for (const BigInt& b : { top, top + 1, top - 1 + top, (BigInt(1) << (32 * bn)) - 1, top + B - 1 }) {
+			for (const BigInt& q : { BigInt(1), B - 1, B * B - 1, top - 1 }) {
+				checkDivision(b * q + b - 1, b);
+				checkDivision(b * q, b);
+				CHECK_EQ(b * q / b, q);
+			}
+		}
+	}
+	//Hacker's Delight中需要加回的例子
+	BigInt u = util::from_string("7fffffff800000000000000000000000", 16);
+	BigInt v = util::from_string("800000000000000000000003", 16);
+	checkDivision(u, v);
+	CHECK_EQ(util::to_string(u / v, 16), "fffffffe");
+}
+
+TEST(newtonMatchesBasecase) {
+	for (uint32_t bn : { 65u, 100u, 257u, 1000u }) {
+		for (uint32_t qn : { 1u, 2u, bn - 1, bn, bn + 1, 3 * bn }) {
+			Limbs b = test::randomLimbs(bn), a = test::randomLimbs(bn + qn - 1);
+			CHECK_EQ(quotientAndRemainder(limbs::divmodNewton, a, b), quotientAndRemainder(limbs::divmodBasecase, a, b));
+		}
+	}
+	//除数是B^n - 1和B^(n - 1)时倒数的估计最容易偏差
+	for (uint32_t bn : { 70u, 128u }) {
+		Limbs ones(bn, 0xffffffffu), power(bn, 0);
+		power[bn - 1] = 1;
+		Limbs a = test::randomLimbs(3 * bn);
+		CHECK_EQ(quotientAndRemainder(limbs::divmodNewton, a, ones), quotientAndRemainder(limbs::divmodBasecase, a, ones));
+		CHECK_EQ(quotientAndRemainder(limbs::divmodNewton, a, power), quotientAndRemainder(limbs::divmodBasecase, a, power));
+	}
+}
+
+//divmod在除数和商都达到newton_div_threshold时改用牛顿迭代
+TEST(divisionAroundNewtonThreshold) {
+	const uint64_t t = limbs::newton_div_threshold;
+	for (uint64_t bn : { t - 1, t, t + 1 }) {
+		for (uint64_t qn : { t - 1, t + 1 }) {
+			BigInt b = test::randomExact(32 * bn), a = test::randomExact(32 * (bn + qn));
+			checkDivision(a, b);
+			checkDivision(BigInt(0) - a, b);
+		}
+	}
+}
+
+TEST(divisionOfZeroAndByOne) {
+	BigInt x = test::randomExact(500);
+	CHECK_EQ(BigInt(0) / x, BigInt(0));
+	CHECK_EQ(BigInt(0) % x, BigInt(0));
+	CHECK_EQ(x / 1, x);
+	CHECK_EQ(x % 1, BigInt(0));
+	CHECK_EQ(x / x, BigInt(1));
+	CHECK_EQ(x % x, BigInt(0));
+	CHECK((BigInt() / x).isNaN());
+	CHECK((x % BigInt()).isNaN());
+}
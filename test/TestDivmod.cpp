@@ -0,0 +1,68 @@
+#include<limits>
+
+#include"test/Test.h"
+
+TEST(divmodMatchesOperators) {
+	for (int i = 0; i < 300; ++i) {
+		BigInt a = test::random(2500, true), b = test::random(1200, true);
+		if (b == 0) continue;
+		auto [q, r] = util::divmod(a, b);
+		CHECK_EQ(q, a / b);
+		CHECK_EQ(r, a % b);
+		CHECK_EQ(q * b + r, a);
+	}
+	auto [q, r] = util::divmod(BigInt(-7), BigInt(2));
+	CHECK_EQ(q, BigInt(-3));
+	CHECK_EQ(r, BigInt(-1));
+	CHECK(util::divmod(BigInt(), BigInt(3)).first.isNaN());
+	CHECK(util::divmod(BigInt(3), BigInt()).second.isNaN());
+	CHECK_THROWS(util::divmod(BigInt(3), BigInt(0)), std::domain_error);
+}
+
+//除数是机器字时分别走单limb和双limb的路径，余数与被除数同号
+TEST(divmodByWord) {
+	const long long divisors[] = { 1, -1, 2, -3, 10, 0xffffffffll, 0x100000000ll, -0x100000001ll, 1000000007, 0x7fffffffffffffffll, std::numeric_limits<long long>::min() };
+	for (int i = 0; i < 100; ++i) {
+		BigInt a = test::random(600, true);
+		for (long long d : divisors) {
+			auto [q, r] = util::divmod(a, d);
+			CHECK_EQ(q, a / BigInt(d));
+			CHECK_EQ(BigInt(r), a % BigInt(d));
+		}
+	}
+	//被除数只有一个limb而除数超过32位
+	auto [q, r] = util::divmod(BigInt(-12345), 0x100000000ll);
+	CHECK_EQ(q, BigInt(0));
+	CHECK_EQ(r, -12345ll);
+	auto [q0, r0] = util::divmod(BigInt(0), -5);
+	CHECK_EQ(q0, BigInt(0));
+	CHECK_EQ(r0, 0ll);
+	CHECK(util::sign(q0));
+	CHECK(util::divmod(BigInt(), 3).first.isNaN());
+	CHECK_THROWS(util::divmod(BigInt(3), 0ll), std::domain_error);
+}
+
+//无符号的除数不能被转换成long long，超过LLONG_MAX时走一般的除法
+TEST(divmodByUnsignedWord) {
+	const unsigned long long divisors[] = { 1ull, 10ull, 0x7fffffffffffffffull, 0x8000000000000000ull, 0xF000000000000000ull, 0xffffffffffffffffull };
+	for (int i = 0; i < 100; ++i) {
+		BigInt a = test::random(600, true);
+		for (unsigned long long d : divisors) {
+			auto [q, r] = util::divmod(a, d);
+			CHECK_EQ(q, a / BigInt(d));
+			CHECK_EQ(r, a % BigInt(d));
+		}
+	}
+	auto [q, r] = util::divmod(BigInt(1) << 100, 0xF000000000000000ull);
+	CHECK_EQ(q, BigInt(73300775185ll));
+	CHECK_EQ(q * BigInt(0xF000000000000000ull) + r, BigInt(1) << 100);
+	auto [qn, rn] = util::divmod(BigInt(-7), 2u);
+	CHECK_EQ(qn, BigInt(-3));
+	CHECK_EQ(rn, BigInt(-1));
+	auto [qs, rs] = util::divmod(BigInt(100), size_t(7));
+	CHECK_EQ(qs, BigInt(14));
+	CHECK_EQ(rs, BigInt(2));
+	CHECK(util::divmod(BigInt(), 3u).second.isNaN());
+	CHECK_THROWS(util::divmod(BigInt(3), 0u), std::domain_error);
+	CHECK_THROWS(util::divmod(BigInt(3), 0ull), std::domain_error);
+}
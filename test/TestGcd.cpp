@@ -0,0 +1,138 @@
+#include<stdexcept>
+#include<tuple>
+
+#include"test/Test.h"
+
+namespace {
+	BigInt abs(const BigInt& x) {
+		return x < 0 ? BigInt(0) - x : x;
+	}
+
+	//辗转相除，作为参照
+	BigInt euclid(BigInt a, BigInt b) {
+		a = abs(a);
+		b = abs(b);
+		while (b != 0) {
+			BigInt t = a % b;
+			a = std::move(b);
+			b = std::move(t);
+		}
+		return a;
+	}
+
+	//g整除a, b且a * x + b * y = g时，g就是最大公约数
+	void checkExtended(const BigInt& a, const BigInt& b) {
+		auto [g, x, y] = util::extended_gcd(a, b);
+		CHECK(g >= 0);
+		CHECK_EQ(a * x + b * y, g);
+		if (g != 0) {
+			CHECK_EQ(a % g, BigInt(0));
+			CHECK_EQ(b % g, BigInt(0));
+		}
+		if (b != 0) {
+			//-|b| / 2g < x <= |b| / 2g
+			BigInt twice = g * x * 2;
+			CHECK(twice > BigInt(0) - abs(b));
+			CHECK(twice <= abs(b));
+		}
+		CHECK_EQ(util::gcd(a, b), g);
+	}
+}
+
+//长度覆盖二进制gcd、Lehmer以及hgcd递归和分治的路径，一半的输入有公因子
+TEST(gcdMatchesEuclid) {
+	for (uint32_t limbs : { 1u, 2u, 3u, 20u, 119u, 130u, 300u }) {
+		for (int i = 0; i < 6; ++i) {
+			BigInt a = test::random(32 * limbs, true), b = test::random(32 * limbs - 5 * i, true);
+			if (i % 2) {
+				BigInt f = test::random(32 * limbs / 3) + BigInt(1);
+				a *= f;
+				b *= f;
+			}
+			CHECK_EQ(util::gcd(a, b), euclid(a, b));
+			checkExtended(a, b);
+		}
+	}
+}
+
+TEST(gcdLongOperands) {
+	for (uint32_t limbs : { 400u, 450u, 1000u }) {
+		for (int i = 0; i < 2; ++i) {
+			BigInt f = test::randomExact(32 * limbs / 4);
+			BigInt a = test::randomExact(32 * limbs) * (i ? f : BigInt(1)), b = test::randomExact(32 * limbs - 40) * (i ? f : BigInt(1));
+			CHECK_EQ(util::gcd(a, b), euclid(a, b));
+			checkExtended(a, b);
+			checkExtended(b, a);
+		}
+	}
+	//相邻的斐波那契数每步商都是1，是Lehmer和hgcd最慢的输入
+	BigInt f0(0), f1(1);
+	for (int i = 0; i < 20000; ++i) {
+		BigInt t = f0 + f1;
+		f0 = std::move(f1);
+		f1 = std::move(t);
+	}
+	CHECK(f1._size > 400);
+	CHECK_EQ(util::gcd(f1, f0), BigInt(1));
+	checkExtended(f1, f0);
+	CHECK_EQ(util::gcd(f1 * f0, f0 * f0), f0);
+}
+
+TEST(gcdEdgeCases) {
+	CHECK_EQ(util::gcd(BigInt(0), BigInt(0)), BigInt(0));
+	CHECK_EQ(util::gcd(BigInt(-12), BigInt(0)), BigInt(12));
+	CHECK_EQ(util::gcd(BigInt(0), BigInt(-12)), BigInt(12));
+	CHECK_EQ(util::gcd(BigInt(-12), BigInt(-18)), BigInt(6));
+	CHECK(util::gcd(BigInt(), BigInt(3)).isNaN());
+	BigInt big = BigInt(1) << 3000;
+	CHECK_EQ(util::gcd(big, BigInt(1) << 70), BigInt(1) << 70);
+	CHECK_EQ(util::gcd(big + BigInt(1), big), BigInt(1));
+	for (auto [a, b] : { std::pair<int, int>{ 0, 0 }, { 5, 0 }, { 0, -5 }, { -4, 6 }, { 1, 1 }, { 240, 46 }, { -17, -17 } }) {
+		checkExtended(BigInt(a), BigInt(b));
+	}
+	auto [g, x, y] = util::extended_gcd(BigInt(), BigInt(1));
+	CHECK(g.isNaN() && x.isNaN() && y.isNaN());
+}
+
+TEST(lcmProperties) {
+	for (int i = 0; i < 50; ++i) {
+		BigInt a = test::random(500, true), b = test::random(300, true);
+		BigInt l = util::lcm(a, b);
+		CHECK(l >= 0);
+		if (a == 0 || b == 0) {
+			CHECK_EQ(l, BigInt(0));
+			continue;
+		}
+		CHECK_EQ(l % a, BigInt(0));
+		CHECK_EQ(l % b, BigInt(0));
+		CHECK_EQ(l * util::gcd(a, b), abs(a * b));
+	}
+	CHECK_EQ(util::lcm(BigInt(-4), BigInt(6)), BigInt(12));
+	CHECK_EQ(util::lcm(BigInt(0), BigInt(6)), BigInt(0));
+	CHECK(util::lcm(BigInt(4), BigInt()).isNaN());
+}
+
+TEST(modInverse) {
+	for (uint64_t bits : { 8, 64, 500, 20000 }) {
+		BigInt m = test::randomExact(bits) | BigInt(1);
+		for (int i = 0; i < 10; ++i) {
+			BigInt a = test::random(bits + 20, true);
+			if (util::gcd(a, m) != 1) {
+				CHECK_THROWS(util::mod_inverse(a, m), std::domain_error);
+				continue;
+			}
+			BigInt inv = util::mod_inverse(a, m);
+			CHECK(inv >= 0 && inv < m);
+			BigInt r = a * inv % m;
+			if (r < 0) r += m;
+			CHECK_EQ(r, BigInt(1));
+		}
+	}
+	CHECK_EQ(util::mod_inverse(BigInt(3), BigInt(1)), BigInt(0));
+	CHECK_EQ(util::mod_inverse(BigInt(-3), BigInt(7)), BigInt(2));
+	CHECK_THROWS(util::mod_inverse(BigInt(4), BigInt(8)), std::domain_error);
+	CHECK_THROWS(util::mod_inverse(BigInt(0), BigInt(7)), std::domain_error);
+	CHECK_THROWS(util::mod_inverse(BigInt(3), BigInt(0)), std::domain_error);
+	CHECK_THROWS(util::mod_inverse(BigInt(3), BigInt(-7)), std::domain_error);
+	CHECK(util::mod_inverse(BigInt(), BigInt(7)).isNaN());
+}
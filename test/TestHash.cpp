@@ -0,0 +1,64 @@
+#include<unordered_map>
+#include<unordered_set>
+
+#include"test/Test.h"
+
+//相等的值哈希相同，与存储位置(内联或堆)和容量无关
+TEST(hashDependsOnlyOnValue) {
+	std::hash<BigInt> h;
+	for (int i = 0; i < 200; ++i) {
+		const BigInt a = test::random(600, true);
+		BigInt b = a;
+		b += BigInt(1) << 2000;
+		b -= BigInt(1) << 2000;
+		CHECK_EQ(b, a);
+		CHECK_EQ(h(a), h(b));
+		CHECK_EQ(h(a), h(BigInt(util::to_string(a))));
+	}
+	CHECK_EQ(h(BigInt(0)), h(BigInt(-1) + 1));
+	CHECK(h(BigInt(1)) != h(BigInt(-1)));
+	//不同长度的0 limb不能互相抵消
+	CHECK(h(BigInt(1) << 32) != h(BigInt(1) << 64));
+	CHECK_EQ(h(BigInt()), h(BigInt()));
+}
+
+TEST(hashDoesNotAllocate) {
+	const BigInt big = test::randomExact(5000);
+	uint64_t before = util::heap_allocations();
+	std::size_t x = std::hash<BigInt>{}(big);
+	std::size_t y = std::hash<BigInt>{}(BigInt(42));
+	CHECK_EQ(util::heap_allocations(), before);
+	CHECK(x != y);
+}
+
+//连续整数不应该大量碰撞
+TEST(hashSpreadsConsecutiveValues) {
+	std::unordered_set<std::size_t> seen;
+	const BigInt base = BigInt(1) << 100;
+	for (int i = 0; i < 10000; ++i) {
+		seen.insert(std::hash<BigInt>{}(base + i));
+		seen.insert(std::hash<BigInt>{}(BigInt(i)));
+	}
+	CHECK(seen.size() > 19990);
+}
+
+TEST(hashedBigIntKeys) {
+	std::unordered_map<HashedBigInt, int> m;
+	std::unordered_map<BigInt, int> plain;
+	for (int i = 0; i < 500; ++i) {
+		BigInt k = BigInt(i) * 1000000007 << 70;
+		m.emplace(k, i);
+		plain.emplace(k, i);
+	}
+	for (int i = 0; i < 500; ++i) {
+		BigInt k = BigInt(i) * 1000000007 << 70;
+		HashedBigInt key(k);
+		CHECK_EQ(key.hash(), std::hash<BigInt>{}(k));
+		CHECK_EQ(key.value(), k);
+		CHECK_EQ(m.at(key), i);
+		CHECK_EQ(plain.at(k), i);
+	}
+	CHECK(m.find(HashedBigInt(BigInt(3))) == m.end());
+	CHECK(HashedBigInt(BigInt(5)) == HashedBigInt(BigInt(5)));
+	CHECK(HashedBigInt(BigInt(5)) != HashedBigInt(BigInt(-5)));
+}
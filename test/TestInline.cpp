@@ -0,0 +1,65 @@
+#include<utility>
+#include<limits>
+
+#include"test/Test.h"
+
+//结果不超过128位的运算都应该只使用对象内部的存储
+TEST(smallOperationsDoNotAllocate) {
+	const BigInt max64(std::numeric_limits<unsigned long long>::max());
+	const BigInt p127 = BigInt(1) << 127;
+	//预热，排除一次性的初始化
+	BigInt warm = max64 * max64 / 3 % 7;
+	uint64_t before = util::heap_allocations();
+
+	const BigInt a(1234567), b(-89), c(std::numeric_limits<long long>::min());
+	BigInt sum = a + b + c;
+	BigInt diff = c - max64;
+	//3个limb乘2个limb，结果不超过128位
+	BigInt x = BigInt(1) << 70, y(1ull << 50);
+	BigInt prod = x * y;
+	BigInt prod2 = max64 * max64;
+	BigInt prod3 = p127 * BigInt(1);
+	BigInt quo = prod2 / max64, rem = prod2 % a;
+	auto [q, r] = util::divmod(prod2, b);
+	BigInt acc = p127;
+	acc += 1;
+	acc -= max64;
+	acc *= 1;
+	acc /= 3;
+	acc %= max64;
+	BigInt top = p127 - 1;
+	top += top;
+	BigInt neg = -p127;
+	neg -= p127;
+	BigInt copy(p127), moved(std::move(copy));
+	copy = moved;
+	moved = std::move(prod2);
+	BigInt shifted = (max64 << 64) >> 3;
+	BigInt bits = (shifted & -a) | (b ^ max64);
+	BigInt inv = ~p127;
+	++inv;
+	inv--;
+	util::set_bit(inv, 127);
+	bool cmp = a < b || c == max64 || a.compare(12345) > 0;
+	long long ll = static_cast<long long>(c);
+
+	CHECK_EQ(util::heap_allocations(), before);
+	//确认上面的运算确实发生了
+	CHECK_EQ(util::to_string(prod), "1329227995784915872903807060280344576");
+	CHECK_EQ(prod3, p127);
+	CHECK_EQ(quo, max64);
+	CHECK_EQ(q * b + BigInt(r), moved);
+	CHECK_EQ(top, (p127 - 1) * 2);
+	CHECK_EQ(neg, BigInt(0) - p127 * 2);
+	CHECK_EQ(copy, p127);
+	CHECK(cmp);
+	CHECK_EQ(ll, std::numeric_limits<long long>::min());
+	CHECK(!rem.isNaN() && !bits.isNaN() && !sum.isNaN() && !diff.isNaN() && !acc.isNaN() && !warm.isNaN());
+}
+
+TEST(largeValuesGoToTheHeap) {
+	uint64_t before = util::heap_allocations();
+	BigInt x = BigInt(1) << 200;
+	CHECK(util::heap_allocations() > before);
+	CHECK_EQ(util::bit_length(x), 201u);
+}
@@ -0,0 +1,145 @@
+#include<vector>
+
+#include"test/Test.h"
+
+using limbs::limb_t;
+using limbs::dlimb_t;
+using Limbs = std::vector<limb_t>;
+
+//逐limb的参考实现，与x64上的展开版本对照
+static limb_t refAdd(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+	dlimb_t carry{ 0 };
+	for (uint32_t i = 0; i < an; ++i) {
+		carry += dlimb_t(a[i]) + (i < bn ? b[i] : 0);
+		res[i] = limb_t(carry);
+		carry >>= 32;
+	}
+	return limb_t(carry);
+}
+
+static limb_t refSub(limb_t* res, const limb_t* a, uint32_t an, const limb_t* b, uint32_t bn) {
+	limb_t borrow{ 0 };
+	for (uint32_t i = 0; i < an; ++i) {
+		dlimb_t d = dlimb_t(a[i]) - (i < bn ? b[i] : 0) - borrow;
+		res[i] = limb_t(d);
+		borrow = limb_t(d >> 63);
+	}
+	return borrow;
+}
+
+static limb_t refAddMul(limb_t* res, const limb_t* a, uint32_t an, limb_t m) {
+	dlimb_t carry{ 0 };
+	for (uint32_t i = 0; i < an; ++i) {
+		carry += dlimb_t(a[i]) * m + res[i];
+		res[i] = limb_t(carry);
+		carry >>= 32;
+	}
+	return limb_t(carry);
+}
+
+//每个长度都试随机、全1和全0的组合，全1加1会一路进位到最高位
+static std::vector<Limbs> operands(uint32_t n) {
+	std::vector<Limbs> ret{ test::randomLimbs(n), Limbs(n, 0xffffffffu), Limbs(n, 0) };
+	Limbs one(n, 0);
+	if (n > 0) one[0] = 1;
+	ret.push_back(one);
+	return ret;
+}
+
+TEST(addSubKernels) {
+	for (uint32_t an = 0; an <= 40; ++an) {
+		for (uint32_t bn = 0; bn <= an; ++bn) {
+			for (const Limbs& a : operands(an)) {
+				for (const Limbs& b : operands(bn)) {
+					Limbs expected(an), actual(an);
+					limb_t c1 = refAdd(expected.data(), a.data(), an, b.data(), bn);
+					limb_t c2 = limbs::add(actual.data(), a.data(), an, b.data(), bn);
+					CHECK_EQ(actual, expected);
+					CHECK_EQ(c2, c1);
+					//结果写回a本身
+					Limbs in_place = a;
+					limbs::add(in_place.data(), in_place.data(), an, b.data(), bn);
+					CHECK_EQ(in_place, expected);
+					//sub要求a >= b
+					if (refSub(expected.data(), a.data(), an, b.data(), bn) != 0) continue;
+					CHECK_EQ(limbs::sub(actual.data(), a.data(), an, b.data(), bn), 0u);
+					CHECK_EQ(actual, expected);
+				}
+			}
+		}
+	}
+}
+
+TEST(singleLimbKernels) {
+	const limb_t multipliers[] = { 0, 1, 2, 0x7fffffffu, 0x80000000u, 0xffffffffu, 1000000007u };
+	for (uint32_t n = 0; n <= 40; ++n) {
+		for (const Limbs& a : operands(n)) {
+			for (limb_t m : multipliers) {
+				Limbs zero(n, 0), expected = zero, actual(n);
+				limb_t c1 = refAddMul(expected.data(), a.data(), n, m);
+				limb_t c2 = limbs::mulBySingle(actual.data(), a.data(), n, m);
+				CHECK_EQ(actual, expected);
+				CHECK_EQ(c2, c1);
+				Limbs acc = a, acc_ref = a;
+				c1 = refAddMul(acc_ref.data(), a.data(), n, m);
+				c2 = limbs::addMulBySingle(acc.data(), a.data(), n, m);
+				CHECK_EQ(acc, acc_ref);
+				CHECK_EQ(c2, c1);
+				if (m == 0) continue;
+				//(a * m + r) / m == a
+				Limbs prod(n + 1), quo(n + 1);
+				prod[n] = limbs::mulBySingle(prod.data(), a.data(), n, m);
+				limb_t r = m / 3;
+				limbs::add(prod.data(), prod.data(), n + 1, &r, 1);
+				CHECK_EQ(limbs::divBySingle(quo.data(), prod.data(), n + 1, m), r);
+				quo.pop_back();
+				CHECK_EQ(quo, a);
+			}
+		}
+	}
+}
+
+TEST(shiftKernels) {
+	for (uint32_t n = 1; n <= 40; ++n) {
+		for (const Limbs& a : operands(n)) {
+			for (int shift = 0; shift < 32; ++shift) {
+				Limbs l(n), r(n);
+				limb_t out = limbs::lshift(l.data(), a.data(), n, shift);
+				//左移后再右移回来，移出的高位拼回最高limb
+				limb_t low = limbs::rshift(r.data(), l.data(), n, shift);
+				if (shift > 0) r[n - 1] |= out << (32 - shift);
+				CHECK_EQ(r, a);
+				CHECK_EQ(low, 0u);
+				for (uint32_t i = 0; i < n; ++i) {
+					limb_t expected = shift == 0 ? a[i] : (a[i] << shift) | (i > 0 ? a[i - 1] >> (32 - shift) : 0);
+					CHECK_EQ(l[i], expected);
+				}
+				Limbs in_place = a;
+				limbs::rshift(in_place.data(), in_place.data(), n, shift);
+				limb_t expected_low = shift == 0 ? 0 : a[0] << (32 - shift);
+				CHECK_EQ(limbs::rshift(r.data(), a.data(), n, shift), expected_low);
+				CHECK_EQ(in_place, r);
+			}
+		}
+	}
+}
+
+TEST(compareKernel) {
+	for (uint32_t n = 1; n <= 40; ++n) {
+		Limbs a = test::randomLimbs(n), b = a;
+		CHECK_EQ(limbs::compare(a.data(), n, b.data(), n), 0);
+		for (uint32_t i = 0; i < n; ++i) {
+			b = a;
+			b[i] ^= 1;
+			int expected = a[i] > b[i] ? 1 : -1;
+			CHECK_EQ(limbs::compare(a.data(), n, b.data(), n), expected);
+		}
+		//较长的一方更大
+		CHECK_EQ(limbs::compare(a.data(), n, a.data(), n - 1), 1);
+		CHECK_EQ(limbs::compare(a.data(), n - 1, a.data(), n), -1);
+		CHECK_EQ(limbs::normalizedSize(a.data(), n), n);
+		Limbs padded = a;
+		padded.resize(n + 5, 0);
+		CHECK_EQ(limbs::normalizedSize(padded.data(), n + 5), n);
+	}
+}
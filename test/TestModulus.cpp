@@ -0,0 +1,151 @@
+#include<stdexcept>
+
+#include"test/Test.h"
+
+namespace {
+	BigInt naiveMod(const BigInt& x, const BigInt& m) {
+		BigInt r = x % m;
+		if (r < 0) r += m;
+		return r;
+	}
+
+	BigInt naivePow(BigInt base, uint64_t exp, const BigInt& m) {
+		BigInt ret = naiveMod(BigInt(1), m);
+		base = naiveMod(base, m);
+		for (; exp; exp >>= 1) {
+			if (exp & 1) ret = naiveMod(ret * base, m);
+			base = naiveMod(base * base, m);
+		}
+		return ret;
+	}
+
+	//奇数走Montgomery，偶数走Barrett；长度覆盖单limb、补齐到偶数以及平方走karatsuba的情况
+	std::vector<BigInt> moduli() {
+		std::vector<BigInt> ret{ BigInt(1), BigInt(2), BigInt(3), BigInt(0xffffffffll), BigInt(0x100000000ll) };
+		for (uint64_t bits : { 33, 64, 65, 96, 200, 1100, 3300 }) {
+			BigInt m = test::randomExact(bits);
+			ret.push_back(m | BigInt(1));
+			ret.push_back(m - (m & BigInt(1)) + BigInt(2));
+		}
+		return ret;
+	}
+}
+
+TEST(modulusMulSquare) {
+	for (const BigInt& m : moduli()) {
+		Modulus mod(m);
+		uint64_t bits = util::bit_length(m);
+		for (int i = 0; i < 20; ++i) {
+			//既有[0, m)内的，也有负数和超过m的
+			BigInt a = test::random(bits, i % 2 == 0), b = test::random(bits * (i % 3 + 1), true);
+			CHECK_EQ(mod.reduce(a), naiveMod(a, m));
+			CHECK_EQ(mod.mul(a, b), naiveMod(a * b, m));
+			CHECK_EQ(mod.square(a), naiveMod(a * a, m));
+		}
+		CHECK_EQ(mod.square(m - BigInt(1)), naiveMod(BigInt(1), m));
+	}
+	CHECK(Modulus(BigInt(7)).mul(BigInt(), BigInt(3)).isNaN());
+	CHECK(Modulus(BigInt(8)).square(BigInt()).isNaN());
+	CHECK_THROWS(Modulus(BigInt(0)), std::domain_error);
+	CHECK_THROWS(Modulus(BigInt(-5)), std::domain_error);
+	CHECK_THROWS(Modulus(BigInt()), std::domain_error);
+}
+
+//在约简域中连续运算的结果与每步取模一致，模数较短时转换出来之前不再分配内存
+TEST(modulusResidueChain) {
+	for (const BigInt& m : moduli()) {
+		Modulus mod(m);
+		uint64_t bits = util::bit_length(m);
+		BigInt a = test::random(bits + 10, true), b = test::random(bits, true);
+		Modulus::Residue x = mod.to_domain(a), y = mod.to_domain(b), z;
+		CHECK_EQ(mod.from_domain(x), naiveMod(a, m));
+		BigInt expected = naiveMod(a, m);
+		//第一轮让z和线程的临时空间分配好
+		mod.mul(z, x, y);
+		expected = naiveMod(expected * b, m);
+		uint64_t before = test::allocations();
+		for (int i = 0; i < 10; ++i) {
+			mod.square(z, z);
+			mod.mul(z, z, y);
+			mod.mul(z, x, z);
+		}
+		//更长的乘法会用karatsuba，临时空间由乘法自己分配
+		if (bits <= 900) CHECK_EQ(test::allocations(), before);
+		for (int i = 0; i < 10; ++i) expected = naiveMod(expected * expected * b * a, m);
+		CHECK_EQ(mod.from_domain(z), expected);
+		mod.to_domain(z, b);
+		CHECK_EQ(mod.from_domain(z), naiveMod(b, m));
+	}
+	CHECK_THROWS(Modulus(BigInt(9)).to_domain(BigInt()), std::domain_error);
+}
+
+TEST(modulusPow) {
+	for (const BigInt& m : moduli()) {
+		Modulus mod(m);
+		uint64_t bits = util::bit_length(m);
+		for (uint64_t exp : { 0ull, 1ull, 2ull, 3ull, 23ull, 24ull, 1000ull, 0xfedcba9876ull }) {
+			BigInt base = test::random(bits + 5, true);
+			CHECK_EQ(mod.pow(base, BigInt(exp)), naivePow(base, exp, m));
+			CHECK_EQ(util::powmod(base, BigInt(exp), m), naivePow(base, exp, m));
+		}
+	}
+	//指数很长时用最大的窗口
+	BigInt m = test::randomExact(300) | BigInt(1), base = test::random(300), exp = test::randomExact(800);
+	BigInt expected = naiveMod(BigInt(1), m);
+	for (int64_t i = int64_t(util::bit_length(exp)) - 1; i >= 0; --i) {
+		expected = naiveMod(expected * expected, m);
+		if (util::test_bit(exp, uint64_t(i))) expected = naiveMod(expected * base, m);
+	}
+	CHECK_EQ(Modulus(m).pow(base, exp), expected);
+
+	//负指数先求逆元
+	BigInt p(1000000007);
+	Modulus mp(p);
+	CHECK_EQ(mp.mul(mp.pow(BigInt(12345), BigInt(-3)), mp.pow(BigInt(12345), BigInt(3))), BigInt(1));
+	CHECK_THROWS(Modulus(BigInt(12)).pow(BigInt(4), BigInt(-1)), std::domain_error);
+	CHECK(mp.pow(BigInt(), BigInt(2)).isNaN());
+}
+
+//redc(t) * 2^(32n) ≡ t (mod m)，t取到上限m * 2^(32n) - 1附近
+TEST(redcMontgomeryKernel) {
+	for (uint32_t n : { 2u, 4u, 10u, 64u }) {
+		for (int i = 0; i < 20; ++i) {
+			std::vector<limbs::limb_t> m = test::randomLimbs(n);
+			m[0] |= 1;
+			uint64_t m0 = m[0] | uint64_t(m[1]) << 32, x = m0;
+			for (int k = 0; k < 5; ++k) x *= 2 - m0 * x;
+			BigInt mv(0), R(1);
+			for (uint32_t j = n; j-- > 0;) mv = (mv << 32) + BigInt(m[j]);
+			R <<= 32 * n;
+			BigInt tv = i == 0 ? mv * R - BigInt(1) : test::random(64 * n) % (mv * R);
+			std::vector<limbs::limb_t> t(2 * n, 0), res(n);
+			for (uint32_t j = 0; j < 2 * n; ++j) t[j] = limbs::limb_t(util::try_convert<uint64_t>((tv >> (32 * j)) & BigInt(0xffffffffll)).value_or(0));
+			limbs::redcMontgomery(res.data(), t.data(), m.data(), n, 0 - x);
+			BigInt rv(0);
+			for (uint32_t j = n; j-- > 0;) rv = (rv << 32) + BigInt(res[j]);
+			CHECK(rv < mv);
+			CHECK_EQ(naiveMod(rv * R, mv), naiveMod(tv, mv));
+		}
+	}
+}
+
+//平方与mulMontgomery(a, a)一致，长度跨过改用交叉项的阈值
+TEST(sqrMontgomeryKernel) {
+	for (uint32_t n : { 2u, 8u, 22u, 24u, 26u, 64u, 100u }) {
+		for (int i = 0; i < 10; ++i) {
+			std::vector<limbs::limb_t> m = test::randomLimbs(n), a = test::randomLimbs(n);
+			m[0] |= 1;
+			m[n - 1] |= 0x80000000u;
+			a[n - 1] &= i == 0 ? 0xfffffffeu : 0x7fffffffu;
+			if (i == 0) a = std::vector<limbs::limb_t>(m.begin(), m.end()), a[0] -= 1;
+			uint64_t m0 = m[0] | uint64_t(m[1]) << 32, x = m0;
+			for (int k = 0; k < 5; ++k) x *= 2 - m0 * x;
+			std::vector<limbs::limb_t> expected(n), res(n), scratch(2 * n);
+			limbs::mulMontgomery(expected.data(), a.data(), a.data(), m.data(), n, 0 - x, scratch.data());
+			limbs::sqrMontgomery(res.data(), a.data(), m.data(), n, 0 - x, scratch.data());
+			CHECK_EQ(res, expected);
+			limbs::sqrMontgomery(a.data(), a.data(), m.data(), n, 0 - x, scratch.data());
+			CHECK_EQ(a, expected);
+		}
+	}
+}
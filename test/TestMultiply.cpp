@@ -0,0 +1,176 @@
+#include<vector>
+#include<algorithm>
+
+#include"test/Test.h"
+
+using Limbs = std::vector<limbs::limb_t>;
+using MulFunction = void(*)(limbs::limb_t*, const limbs::limb_t*, uint32_t, const limbs::limb_t*, uint32_t);
+
+static Limbs product(MulFunction f, const Limbs& a, const Limbs& b) {
+	Limbs ret(a.size() + b.size());
+	f(ret.data(), a.data(), static_cast<uint32_t>(a.size()), b.data(), static_cast<uint32_t>(b.size()));
+	return ret;
+}
+
+static Limbs allOnes(uint32_t n) {
+	return Limbs(n, 0xffffffffu);
+}
+
+TEST(fftMatchesBasecase) {
+	for (int i = 0; i < 200; ++i) {
+		uint32_t an = 1 + test::rng()() % 300, bn = 1 + test::rng()() % 300;
+		Limbs a = test::randomLimbs(an), b = test::randomLimbs(bn);
+		CHECK_EQ(product(limbs::mulFFT, a, b), product(limbs::mulBasecase, a, b));
+	}
+	//长度是2的幂附近时变换长度刚好够或刚好翻倍
+	for (uint32_t n : { 1u, 2u, 3u, 255u, 256u, 257u, 1023u, 1024u, 1025u }) {
+		Limbs a = test::randomLimbs(n), b = test::randomLimbs(n);
+		CHECK_EQ(product(limbs::mulFFT, a, b), product(limbs::mulBasecase, a, b));
+	}
+}
+
+//全1的操作数让卷积系数最大，最容易暴露舍入误差
+TEST(fftAllOnesUpToNttThreshold) {
+	for (uint32_t n : { 64u, 1000u, 4096u }) {
+		Limbs a = allOnes(n);
+		CHECK_EQ(product(limbs::mulFFT, a, a), product(limbs::mulBasecase, a, a));
+	}
+	uint32_t n = limbs::ntt_threshold / 2;
+	Limbs a = allOnes(n);
+	Limbs p = product(limbs::mulFFT, a, a);
+	//(B^n - 1)^2 = B^2n - 2B^n + 1
+	Limbs expected(2 * n, 0xffffffffu);
+	expected[0] = 1;
+	std::fill(expected.begin() + 1, expected.begin() + n, 0);
+	expected[n] = 0xfffffffeu;
+	CHECK_EQ(p, expected);
+}
+
+TEST(fftThroughOperator) {
+	limbs::MulThresholds saved = util::mul_thresholds();
+	for (int i = 0; i < 20; ++i) {
+		BigInt a = test::random(30000, true), b = test::random(30000, true);
+		util::set_mul_thresholds({ 1u << 30, 1u << 30, 1u << 30 });
+		BigInt expected = a * b;
+		util::set_mul_thresholds({ 4, 1u << 30, 4 });
+		CHECK_EQ(a * b, expected);
+	}
+	util::set_mul_thresholds(saved);
+}
+
+TEST(nttMatchesBasecase) {
+	for (int i = 0; i < 100; ++i) {
+		uint32_t an = 1 + test::rng()() % 200, bn = 1 + test::rng()() % 200;
+		Limbs a = test::randomLimbs(an), b = test::randomLimbs(bn);
+		CHECK_EQ(product(limbs::mulNTT, a, b), product(limbs::mulBasecase, a, b));
+	}
+	for (uint32_t n : { 1u, 2u, 511u, 512u, 513u }) {
+		Limbs a = test::randomLimbs(n), b = test::randomLimbs(n);
+		CHECK_EQ(product(limbs::mulNTT, a, b), product(limbs::mulBasecase, a, b));
+	}
+}
+
+TEST(nttMatchesFFT) {
+	for (uint32_t n : { 3000u, 8191u, 12000u }) {
+		Limbs a = test::randomLimbs(n), b = test::randomLimbs(n / 3 + 1);
+		CHECK_EQ(product(limbs::mulNTT, a, b), product(limbs::mulFFT, a, b));
+	}
+}
+
+//超过fft精度范围的全1操作数，结果按闭式核对
+TEST(nttAllOnesAboveFFTRange) {
+	uint32_t n = 3 * limbs::ntt_threshold;
+	Limbs a = allOnes(n);
+	Limbs p = product(limbs::mulNTT, a, a);
+	Limbs expected(2 * n, 0xffffffffu);
+	expected[0] = 1;
+	std::fill(expected.begin() + 1, expected.begin() + n, 0);
+	expected[n] = 0xfffffffeu;
+	CHECK_EQ(p, expected);
+}
+
+TEST(nttThroughOperator) {
+	limbs::MulThresholds saved = util::mul_thresholds();
+	//两个操作数合计超过ntt_threshold个limb时operator*改用ntt
+	BigInt a = test::randomExact(limbs::ntt_threshold * 24), b = test::randomExact(limbs::ntt_threshold * 20);
+	BigInt c = a * b;
+	util::set_mul_thresholds({ saved.karatsuba, saved.toom3, 1u << 30 });
+	CHECK_EQ(c, a * b);
+	util::set_mul_thresholds(saved);
+	CHECK_EQ(c / a, b);
+}
+
+TEST(karatsubaMatchesBasecase) {
+	for (int i = 0; i < 150; ++i) {
+		//较长的操作数不超过较短的两倍
+		uint32_t bn = 2 + test::rng()() % 400, an = bn + test::rng()() % (bn + 1);
+		Limbs a = test::randomLimbs(an), b = test::randomLimbs(bn);
+		CHECK_EQ(product(limbs::mulKaratsuba, a, b), product(limbs::mulBasecase, a, b));
+	}
+}
+
+TEST(toom3MatchesBasecase) {
+	for (int i = 0; i < 150; ++i) {
+		uint32_t bn = 3 + test::rng()() % 1200, an = bn + test::rng()() % (bn + 1);
+		Limbs a = test::randomLimbs(an), b = test::randomLimbs(bn);
+		CHECK_EQ(product(limbs::mulToom3, a, b), product(limbs::mulBasecase, a, b));
+	}
+	//各段长度不同，最高段可能很短
+	for (uint32_t n : { 3u, 4u, 5u, 6u, 7u, 97u, 98u, 99u }) {
+		Limbs a = test::randomLimbs(n), b = test::randomLimbs(n);
+		CHECK_EQ(product(limbs::mulToom3, a, b), product(limbs::mulBasecase, a, b));
+	}
+}
+
+//最不平衡的情况：较长的操作数恰好是较短的两倍，最高段可能为空
+TEST(splitEdgeCases) {
+	for (uint32_t bn = 3; bn < 40; ++bn) {
+		for (uint32_t an : { bn, bn + 1, 2 * bn - 1, 2 * bn }) {
+			Limbs a = test::randomLimbs(an), b = test::randomLimbs(bn);
+			Limbs expected = product(limbs::mulBasecase, a, b);
+			CHECK_EQ(product(limbs::mulKaratsuba, a, b), expected);
+			CHECK_EQ(product(limbs::mulToom3, a, b), expected);
+		}
+	}
+}
+
+//在每个阈值两侧核对分派后的结果
+TEST(dispatchAroundThresholds) {
+	limbs::MulThresholds saved = util::mul_thresholds();
+	const limbs::MulThresholds small{ 8, 24, 96 };
+	for (uint32_t t : { small.karatsuba, small.toom3, small.fft }) {
+		for (uint32_t n = t - 1; n <= t + 1; ++n) {
+			for (uint32_t m : { n, n + 1, 2 * n + 1, 5 * n }) {
+				Limbs a = test::randomLimbs(m), b = test::randomLimbs(n);
+				util::set_mul_thresholds(small);
+				Limbs got = product(limbs::mul, a, b);
+				util::set_mul_thresholds(saved);
+				CHECK_EQ(got, product(limbs::mulBasecase, a, b));
+			}
+		}
+	}
+	util::set_mul_thresholds(saved);
+}
+
+TEST(thresholdsAreClamped) {
+	limbs::MulThresholds saved = util::mul_thresholds();
+	util::set_mul_thresholds({ 0, 0, 0 });
+	limbs::MulThresholds t = util::mul_thresholds();
+	CHECK(t.karatsuba >= 2 && t.toom3 >= 3 && t.fft >= 2);
+	BigInt a = test::random(5000, true), b = test::random(5000, true);
+	BigInt c = a * b;
+	util::set_mul_thresholds(saved);
+	CHECK_EQ(c, a * b);
+}
+
+TEST(multiplySigns) {
+	BigInt a = test::randomExact(3000), b = test::randomExact(2000);
+	BigInt na = BigInt(0) - a, nb = BigInt(0) - b;
+	CHECK_EQ(na * nb, a * b);
+	CHECK_EQ(na * b, BigInt(0) - a * b);
+	CHECK_EQ(a * nb, na * b);
+	CHECK_EQ(a * BigInt(0), BigInt(0));
+	CHECK(util::sign(na * BigInt(0)));
+	CHECK_EQ(a * BigInt(1), a);
+	CHECK_EQ(a * BigInt(-1), na);
+}
@@ -0,0 +1,60 @@
+#include<vector>
+
+#include"test/Test.h"
+
+//用很小的并行阈值让各级乘法和牛顿除法都分到线程池，结果必须与串行完全一致
+TEST(parallelMatchesSerial) {
+	const limbs::ParallelConfig saved = util::parallel_config();
+	std::vector<BigInt> a, b;
+	for (uint64_t bits : { 40 * 32, 500 * 32, 3000 * 32, 20000 * 32 }) {
+		a.push_back(test::randomExact(bits));
+		b.push_back(test::randomExact(bits - 77));
+	}
+	//ntt的区间
+	a.push_back(test::randomExact(40000 * 32));
+	b.push_back(test::randomExact(30000 * 32));
+	const BigInt dividend = test::randomExact(8000 * 32), divisor = test::randomExact(3500 * 32);
+
+	std::vector<BigInt> serial;
+	for (size_t i = 0; i < a.size(); ++i) serial.push_back(a[i] * b[i]);
+	auto [q, r] = util::divmod(dividend, divisor);
+	BigInt sq = util::square(a[2]);
+	for (uint32_t threads : { 2u, 3u, 8u }) {
+		util::set_parallel_config({ threads, 16 });
+		CHECK_EQ(util::parallel_config().threads, threads);
+		for (size_t i = 0; i < a.size(); ++i) CHECK_EQ(a[i] * b[i], serial[i]);
+		auto [pq, pr] = util::divmod(dividend, divisor);
+		CHECK_EQ(pq, q);
+		CHECK_EQ(pr, r);
+		CHECK_EQ(util::square(a[2]), sq);
+	}
+	util::set_parallel_config(saved);
+	CHECK_EQ(util::parallel_config().threads, saved.threads);
+}
+
+TEST(parallelConfigIsClamped) {
+	const limbs::ParallelConfig saved = util::parallel_config();
+	util::set_parallel_config({ 0, 0 });
+	CHECK_EQ(util::parallel_config().threads, 1u);
+	CHECK_EQ(util::parallel_config().threshold, 1u);
+	util::set_parallel_config(saved);
+}
+
+//嵌套的parallelFor不会死锁，每个下标恰好执行一次
+TEST(parallelForNested) {
+	const limbs::ParallelConfig saved = util::parallel_config();
+	util::set_parallel_config({ 4, 1 });
+	std::vector<int> hits(64, 0);
+	limbs::parallelFor(8, [&](uint32_t i) {
+		limbs::parallelFor(8, [&](uint32_t j) { ++hits[i * 8 + j]; });
+	});
+	for (int h : hits) CHECK_EQ(h, 1);
+	uint32_t covered{ 0 };
+	std::vector<int> ranges(1000, 0);
+	limbs::parallelRange(1000, [&](uint32_t first, uint32_t last) {
+		for (uint32_t i = first; i < last; ++i) ++ranges[i];
+	});
+	for (int h : ranges) covered += h;
+	CHECK_EQ(covered, 1000u);
+	util::set_parallel_config(saved);
+}
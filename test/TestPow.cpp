@@ -0,0 +1,79 @@
+#include<stdexcept>
+#include<vector>
+
+#include"test/Test.h"
+
+using Limbs = std::vector<limbs::limb_t>;
+
+static Limbs squareWith(void(*f)(limbs::limb_t*, const limbs::limb_t*, uint32_t), const Limbs& a) {
+	Limbs ret(2 * a.size());
+	f(ret.data(), a.data(), static_cast<uint32_t>(a.size()));
+	return ret;
+}
+
+static Limbs productBasecase(const Limbs& a) {
+	Limbs ret(2 * a.size());
+	limbs::mulBasecase(ret.data(), a.data(), static_cast<uint32_t>(a.size()), a.data(), static_cast<uint32_t>(a.size()));
+	return ret;
+}
+
+//长度跨过basecase、sqrBasecase与karatsuba的分界，全1时交叉项的进位最多
+TEST(sqrMatchesBasecase) {
+	for (uint32_t n : { 1u, 2u, 7u, 8u, 9u, 63u, 64u, 65u, 300u, 1000u }) {
+		for (int i = 0; i < 5; ++i) {
+			Limbs a = i == 0 ? Limbs(n, 0xffffffffu) : test::randomLimbs(n);
+			Limbs expected = productBasecase(a);
+			CHECK_EQ(squareWith(limbs::sqrBasecase, a), expected);
+			CHECK_EQ(squareWith(limbs::sqrFFT, a), expected);
+			CHECK_EQ(squareWith(limbs::sqr, a), expected);
+		}
+	}
+	Limbs a(4096, 0xffffffffu);
+	CHECK_EQ(squareWith(limbs::sqrFFT, a), productBasecase(a));
+}
+
+TEST(squareThroughUtil) {
+	for (uint64_t bits : { 1, 31, 32, 160, 5000, 70000 }) {
+		BigInt x = test::random(bits, true), y = x + BigInt(0);
+		CHECK_EQ(util::square(x), x * y);
+		CHECK_EQ(x * x, x * y);
+		CHECK(util::sign(util::square(x)));
+	}
+	CHECK_EQ(util::square(BigInt(0)), BigInt(0));
+	CHECK(util::square(BigInt()).isNaN());
+}
+
+TEST(powMatchesRepeatedMultiply) {
+	for (int i = 0; i < 60; ++i) {
+		BigInt base = test::random(1 + test::rng()() % 300, true);
+		uint64_t exp = test::rng()() % 40;
+		BigInt expected(1);
+		for (uint64_t k = 0; k < exp; ++k) expected *= base;
+		CHECK_EQ(util::pow(base, exp), expected);
+	}
+	//底数是2的幂时直接移位，负数的奇数次幂为负
+	for (uint32_t k : { 0u, 1u, 31u, 32u, 100u }) {
+		BigInt p = BigInt(1) << k;
+		CHECK_EQ(util::pow(p, 7), BigInt(1) << (7 * k));
+		CHECK_EQ(util::pow(BigInt(0) - p, 7), BigInt(0) - (BigInt(1) << (7 * k)));
+		CHECK_EQ(util::pow(BigInt(0) - p, 6), BigInt(1) << (6 * k));
+	}
+	CHECK_EQ(util::pow(BigInt(0), 0), BigInt(1));
+	CHECK_EQ(util::pow(BigInt(0), 5), BigInt(0));
+	CHECK_EQ(util::pow(BigInt(-1), 1001), BigInt(-1));
+	CHECK(util::pow(BigInt(), 3).isNaN());
+	CHECK_THROWS(util::pow(BigInt(3), uint64_t(1) << 40), std::overflow_error);
+}
+
+//按bits * exp估计的空间比结果多出几个limb，结果放得进对象内部时仍然不分配内存
+TEST(powSmallResultsStayInline) {
+	const std::pair<long long, uint64_t> cases[] = { { 3, 80 }, { -7, 45 }, { 10, 38 }, { 12345, 8 }, { -3, 1 } };
+	for (auto [base, exp] : cases) {
+		BigInt b(base), expected(1);
+		for (uint64_t k = 0; k < exp; ++k) expected *= b;
+		uint64_t before = test::allocations();
+		BigInt p = util::pow(b, exp);
+		CHECK_EQ(test::allocations(), before);
+		CHECK_EQ(p, expected);
+	}
+}
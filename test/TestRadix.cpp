@@ -0,0 +1,120 @@
+#include<string>
+#include<sstream>
+#include<cctype>
+#include<charconv>
+
+#include"test/Test.h"
+
+//覆盖线性转换、逐chunk转换以及超过32个limb的分治转换
+TEST(radixRoundTrip) {
+	for (int base = 2; base <= 36; ++base) {
+		for (uint64_t bits : { 1, 31, 32, 33, 64, 127, 128, 129, 1000, 1030, 1100, 5000, 30000 }) {
+			BigInt x = test::randomExact(bits);
+			std::string s = util::to_string(x, base);
+			CHECK_EQ(util::from_string(s, base), x);
+			CHECK_EQ(util::from_string("-" + s, base), BigInt(0) - x);
+		}
+	}
+}
+
+//十进制的分治转换从288位开始，两侧长度的全9和10^k
+TEST(decimalAroundRecursion) {
+	for (size_t n : { 287, 288, 289, 576, 577, 1000, 4608, 4609, 20000 }) {
+		std::string nines(n, '9');
+		BigInt x(nines);
+		CHECK_EQ(x, util::pow(BigInt(10), n) - 1);
+		CHECK_EQ(util::to_string(x), nines);
+		std::string power = "1" + std::string(n, '0');
+		CHECK_EQ(BigInt(power), util::pow(BigInt(10), n));
+		//前导0不影响结果
+		CHECK_EQ(BigInt(std::string(n, '0') + "12"), BigInt(12));
+	}
+}
+
+TEST(radixDigitsAndCase) {
+	CHECK_EQ(util::to_string(BigInt(255), 16), "ff");
+	CHECK_EQ(util::to_string(BigInt(-35), 36), "-z");
+	CHECK_EQ(util::to_string(BigInt(0), 2), "0");
+	CHECK_EQ(util::from_string("FF", 16), BigInt(255));
+	CHECK_EQ(util::from_string("Zz", 36), BigInt(35 * 36 + 35));
+	CHECK(util::from_string("12", 2).isNaN());
+	CHECK(util::from_string("g", 16).isNaN());
+	CHECK(util::from_string("", 10).isNaN());
+	CHECK_THROWS(util::from_string("1", 1), std::invalid_argument);
+	std::string s = util::to_string(test::randomExact(3000), 36);
+	std::string upper = s;
+	for (char& c : upper) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+	CHECK_EQ(util::from_string(upper, 36), util::from_string(s, 36));
+}
+
+TEST(fromCharsStopsAtFirstInvalid) {
+	std::string s = "-123abc";
+	BigInt x(7);
+	auto [ptr, ec] = util::from_chars(s.data(), s.data() + s.size(), x);
+	CHECK(ec == std::errc());
+	CHECK_EQ(ptr - s.data(), 4);
+	CHECK_EQ(x, BigInt(-123));
+	auto hex = util::from_chars(s.data(), s.data() + s.size(), x, 16);
+	CHECK_EQ(hex.ptr - s.data(), 7);
+	CHECK_EQ(x, BigInt(-0x123abc));
+	std::string bad = "-x";
+	auto r = util::from_chars(bad.data(), bad.data() + bad.size(), x);
+	CHECK(r.ec == std::errc::invalid_argument && r.ptr == bad.data());
+	CHECK_EQ(x, BigInt(-0x123abc));
+	CHECK(util::from_chars(s.data(), s.data() + 1, x, 37).ec == std::errc::invalid_argument);
+}
+
+//不超过128位的数字串只用对象内部的存储
+TEST(shortStringsDoNotAllocate) {
+	const std::string max64 = "18446744073709551615", max128 = "340282366920938463463374607431768211455";
+	BigInt warm("1");
+	std::istringstream in("1234567890 " + max128);
+	uint64_t before = util::heap_allocations();
+	BigInt a("1234567890"), b(max64), c(max128), d("-" + max128), e;
+	util::from_chars(max64.data(), max64.data() + max64.size(), e);
+	BigInt f = util::from_string("ffffffffffffffffffffffffffffffff", 16);
+	BigInt g, h;
+	in >> g >> h;
+	CHECK_EQ(util::heap_allocations(), before);
+	CHECK_EQ(a, BigInt(1234567890));
+	CHECK_EQ(b, BigInt(18446744073709551615ull));
+	CHECK_EQ(c, (BigInt(1) << 128) - 1);
+	CHECK_EQ(c, f);
+	CHECK_EQ(d, BigInt(0) - c);
+	CHECK_EQ(e, b);
+	CHECK_EQ(g, a);
+	CHECK_EQ(h, c);
+	CHECK(!warm.isNaN());
+}
+
+//位数直接由limb估计，radix的整次幂附近要精确比较
+TEST(digitCount) {
+	for (int i = 0; i < 300; ++i) {
+		BigInt x = test::random(1 + test::rng()() % 5000, true);
+		CHECK_EQ(util::digits10(x), uint32_t(util::to_string(x < 0 ? BigInt(0) - x : x).size()));
+	}
+	for (uint64_t n : { 1, 2, 9, 10, 19, 20, 100, 288, 1000, 30000 }) {
+		BigInt p = util::pow(BigInt(10), n);
+		CHECK_EQ(util::digits10(p), uint32_t(n + 1));
+		CHECK_EQ(util::digits10(p - BigInt(1)), uint32_t(n));
+		CHECK_EQ(util::digits10(p + BigInt(1)), uint32_t(n + 1));
+		CHECK_EQ(util::digits10(BigInt(0) - p), uint32_t(n + 1));
+	}
+	for (int radix : { 2, 3, 7, 16, 36 }) {
+		for (uint64_t n : { 1, 5, 13, 200, 2000 }) {
+			BigInt p = util::pow(BigInt(radix), n);
+			for (const BigInt& x : { p - BigInt(1), p, p + BigInt(1), test::random(n * 6) }) {
+				CHECK_EQ(limbs::countDigits(x._limbs, x._size, radix), util::to_string(x, radix).size());
+			}
+		}
+	}
+	CHECK_EQ(util::digits10(BigInt(0)), uint32_t(1));
+	CHECK_EQ(util::digits10(BigInt(-7)), uint32_t(1));
+	CHECK_EQ(util::digits10(BigInt()), uint32_t(0));
+	//不经过字符串，也不分配内存
+	BigInt big = test::randomExact(100000);
+	uint64_t before = test::allocations();
+	uint32_t digits = util::digits10(big);
+	CHECK_EQ(test::allocations(), before);
+	CHECK_EQ(digits, uint32_t(util::to_string(big).size()));
+}
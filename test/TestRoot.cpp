@@ -0,0 +1,110 @@
+#include<set>
+#include<stdexcept>
+
+#include"test/Test.h"
+
+//r^n <= x < (r + 1)^n，x >= 0
+static void checkRoot(const BigInt& x, uint32_t n) {
+	BigInt r = util::iroot(x, n);
+	CHECK(r >= 0);
+	CHECK(util::pow(r, n) <= x);
+	CHECK(util::pow(r + BigInt(1), n) > x);
+}
+
+//长度覆盖机器字的double估计和递归的牛顿迭代，全1和相邻的整次幂最容易暴露修正的错误
+TEST(isqrtBounds) {
+	for (uint64_t bits : { 1, 31, 32, 63, 64, 65, 127, 200, 1000, 5000, 40000 }) {
+		for (int i = 0; i < 10; ++i) {
+			BigInt x = test::random(bits);
+			checkRoot(x, 2);
+			CHECK_EQ(util::isqrt(x), util::iroot(x, 2));
+		}
+		BigInt ones = (BigInt(1) << bits) - BigInt(1);
+		checkRoot(ones, 2);
+		BigInt k = test::randomExact(bits);
+		CHECK_EQ(util::isqrt(k * k), k);
+		CHECK_EQ(util::isqrt(k * k - BigInt(1)), k - BigInt(1));
+		CHECK_EQ(util::isqrt(k * k + k + k), k);
+	}
+	CHECK_EQ(util::isqrt(BigInt(0)), BigInt(0));
+	CHECK_EQ(util::isqrt(BigInt(1)), BigInt(1));
+	CHECK_EQ(util::isqrt(BigInt(3)), BigInt(1));
+	CHECK_EQ(util::isqrt(BigInt(4)), BigInt(2));
+	CHECK_THROWS(util::isqrt(BigInt(-1)), std::domain_error);
+	CHECK(util::isqrt(BigInt()).isNaN());
+}
+
+TEST(irootBounds) {
+	for (uint32_t n : { 3u, 4u, 5u, 7u, 31u, 32u, 100u }) {
+		for (uint64_t bits : { 1, 40, 64, 300, 3000, 20000 }) {
+			BigInt x = test::random(bits);
+			checkRoot(x, n);
+			//负数开奇数次方根向0取整
+			if (n % 2) CHECK_EQ(util::iroot(BigInt(0) - x, n), BigInt(0) - util::iroot(x, n));
+		}
+		BigInt k = test::randomExact(n < 30 ? 700 : 90), p = util::pow(k, n);
+		CHECK_EQ(util::iroot(p, n), k);
+		CHECK_EQ(util::iroot(p - BigInt(1), n), k - BigInt(1));
+		CHECK_EQ(util::iroot(p + BigInt(1), n), k);
+	}
+	BigInt x = test::random(5000, true);
+	CHECK_EQ(util::iroot(x, 1), x);
+	CHECK_EQ(util::iroot(BigInt(-27), 3), BigInt(-3));
+	CHECK_EQ(util::iroot(BigInt(-26), 3), BigInt(-2));
+	CHECK_EQ(util::iroot(BigInt(12345), 1000), BigInt(1));
+	CHECK_THROWS(util::iroot(BigInt(8), 0), std::domain_error);
+	CHECK_THROWS(util::iroot(BigInt(-16), 4), std::domain_error);
+	CHECK(util::iroot(BigInt(), 3).isNaN());
+}
+
+TEST(perfectSquare) {
+	for (int x = 0; x < 5000; ++x) {
+		int r = 0;
+		while ((r + 1) * (r + 1) <= x) ++r;
+		CHECK_EQ(util::is_perfect_square(BigInt(x)), r * r == x);
+	}
+	for (uint64_t bits : { 20, 32, 33, 64, 1000, 30000 }) {
+		BigInt k = test::randomExact(bits), s = k * k;
+		CHECK(util::is_perfect_square(s));
+		CHECK(!util::is_perfect_square(s + BigInt(1)));
+		CHECK(!util::is_perfect_square(s - BigInt(1)));
+		//t = 64 * (2^32 - 1) + 1不是平方数，s * t模64和模2^32 - 1都与s相同，要靠真正开方排除
+		CHECK(!util::is_perfect_square(s * BigInt(274877906881ll)));
+		CHECK(!util::is_perfect_square(s * BigInt(2)));
+	}
+	CHECK(!util::is_perfect_square(BigInt(-4)));
+	CHECK(!util::is_perfect_square(BigInt()));
+}
+
+TEST(perfectPower) {
+	std::set<int> powers{ 0, 1 };
+	for (int y = 2; y * y < 5000; ++y) {
+		for (int p = y * y; p < 5000; p *= y) powers.insert(p);
+	}
+	for (int x = 0; x < 5000; ++x) CHECK_EQ(util::is_perfect_power(BigInt(x)), powers.count(x) > 0);
+	//负数只有奇数次幂
+	CHECK(util::is_perfect_power(BigInt(-1)));
+	CHECK(util::is_perfect_power(BigInt(-8)));
+	CHECK(util::is_perfect_power(BigInt(-32)));
+	CHECK(util::is_perfect_power(BigInt(-64)));
+	CHECK(!util::is_perfect_power(BigInt(-4)));
+	CHECK(!util::is_perfect_power(BigInt(-16)));
+	CHECK(!util::is_perfect_power(BigInt()));
+	//除了8和9，相邻的两个数不会都是整次幂，所以y^k ± 1都不是
+	for (uint32_t k : { 2u, 3u, 5u, 6u, 7u, 12u, 13u, 64u }) {
+		for (uint64_t bits : { 2, 17, 40, 300, 2000 }) {
+			//非整次幂要检查不超过位数的每个素数，限制长度让用例很快跑完
+			if (bits * k > 20000) continue;
+			BigInt y = test::randomExact(bits) + BigInt(2), p = util::pow(y, k);
+			CHECK(util::is_perfect_power(p));
+			CHECK(!util::is_perfect_power(p + BigInt(1)));
+			CHECK(!util::is_perfect_power(p - BigInt(1)));
+			if (k % 2) CHECK(util::is_perfect_power(BigInt(0) - p));
+		}
+	}
+	//末尾0的个数与奇数部分的指数有公因子时才是整次幂
+	CHECK(util::is_perfect_power(BigInt(1) << 3001));
+	CHECK(!util::is_perfect_power(BigInt(3) << 3000));
+	CHECK(util::is_perfect_power(util::pow(BigInt(3), 1001) << 2002));
+	CHECK(!util::is_perfect_power(util::pow(BigInt(3), 1001) << 2001));
+}
@@ -0,0 +1,105 @@
+#include<sstream>
+#include<fstream>
+#include<vector>
+#include<string>
+#include<cstdio>
+#include<cstring>
+
+#include"test/Test.h"
+
+static std::vector<BigInt> sampleValues() {
+	std::vector<BigInt> values{ BigInt(0), BigInt(), BigInt(1), BigInt(-1), BigInt(0x01020304), BigInt(1) << 128, BigInt(0) - (BigInt(1) << 1000) };
+	for (int i = 0; i < 50; ++i) values.push_back(test::random(i < 45 ? 3000 : 200000, true));
+	return values;
+}
+
+//读取要求4字节对齐，复制到limb数组里
+static std::vector<BigInt::limb_t> aligned(const std::string& bytes) {
+	std::vector<BigInt::limb_t> ret((bytes.size() + 3) / 4);
+	std::memcpy(ret.data(), bytes.data(), bytes.size());
+	return ret;
+}
+
+static std::string encode(const std::vector<BigInt>& values) {
+	std::ostringstream out;
+	BigIntWriter writer(out);
+	for (const BigInt& x : values) writer.write(x);
+	return out.str();
+}
+
+TEST(serializeRoundTrip) {
+	std::vector<BigInt> values = sampleValues();
+	std::string bytes = encode(values);
+	std::vector<BigInt::limb_t> data = aligned(bytes);
+	BigIntReader reader(data.data(), bytes.size());
+	BigIntView view;
+	size_t count{ 0 };
+	while (reader.next(view)) {
+		const BigInt& expected = values[count++];
+		CHECK_EQ(view.isNaN(), expected.isNaN());
+		if (expected.isNaN()) {
+			CHECK(view.value().isNaN());
+			continue;
+		}
+		CHECK_EQ(view.value(), expected);
+		CHECK_EQ(view.sign(), util::sign(expected));
+	}
+	CHECK_EQ(count, values.size());
+}
+
+//文件格式固定为小端序：0x01020304的limb依次是04 03 02 01
+TEST(serializeLayout) {
+	std::string bytes = encode({ BigInt(-0x01020304) });
+	std::string expected("BIGI\x01\0\0\0\x05\0\0\0\x04\x03\x02\x01", 16);
+	CHECK_EQ(bytes, expected);
+	std::string empty = encode({ BigInt(0), BigInt() });
+	CHECK_EQ(empty, std::string("BIGI\x01\0\0\0\x00\x02", 10));
+}
+
+TEST(serializeRejectsBadData) {
+	std::string bytes = encode({ BigInt(1) << 100 });
+	std::vector<BigInt::limb_t> data = aligned(bytes);
+	BigIntView view;
+	//截断的limb
+	BigIntReader truncated(data.data(), bytes.size() - 4);
+	CHECK_THROWS(truncated.next(view), std::runtime_error);
+	//版本号不对
+	std::string wrong_version = bytes;
+	wrong_version[4] = 2;
+	std::vector<BigInt::limb_t> wv = aligned(wrong_version);
+	CHECK_THROWS(BigIntReader(wv.data(), wrong_version.size()), std::runtime_error);
+	CHECK_THROWS(BigIntReader(data.data(), 4), std::runtime_error);
+	CHECK_THROWS(BigIntReader(reinterpret_cast<const char*>(data.data()) + 1, bytes.size() - 1), std::invalid_argument);
+	//负0和最高limb为0都不是规范的编码
+	std::string negative_zero("BIGI\x01\0\0\0\x01", 9);
+	std::vector<BigInt::limb_t> nz = aligned(negative_zero);
+	BigIntReader nz_reader(nz.data(), negative_zero.size());
+	CHECK_THROWS(nz_reader.next(view), std::runtime_error);
+	std::string top_zero("BIGI\x01\0\0\0\x04\0\0\0\0\0\0\0", 16);
+	std::vector<BigInt::limb_t> tz = aligned(top_zero);
+	BigIntReader tz_reader(tz.data(), top_zero.size());
+	CHECK_THROWS(tz_reader.next(view), std::runtime_error);
+}
+
+TEST(mappedFile) {
+	std::vector<BigInt> values = sampleValues();
+	const std::string path = "bigint_test_mapped.bin";
+	{
+		std::ofstream out(path, std::ios::binary);
+		BigIntWriter writer(out);
+		for (const BigInt& x : values) writer.write(x);
+	}
+	{
+		MappedBigIntFile file(path);
+		BigIntReader reader = file.reader();
+		BigIntView view;
+		size_t count{ 0 };
+		while (reader.next(view)) {
+			if (!values[count].isNaN()) CHECK_EQ(view.value(), values[count]);
+			++count;
+		}
+		CHECK_EQ(count, values.size());
+	}
+	std::remove(path.c_str());
+	CHECK_THROWS(MappedBigIntFile("bigint_test_missing.bin"), std::runtime_error);
+}
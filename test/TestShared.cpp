@@ -0,0 +1,85 @@
+#include<thread>
+#include<atomic>
+#include<vector>
+
+#include"test/Test.h"
+
+TEST(sharedCopiesShareValue) {
+	const BigInt big = test::randomExact(5000);
+	SharedBigInt a(big);
+	uint64_t before = test::allocations();
+	SharedBigInt b = a, c = b;
+	CHECK_EQ(test::allocations(), before);
+	CHECK_EQ(a.useCount(), 3);
+	CHECK(&a.get() == &c.get());
+	CHECK(a == c);
+	CHECK_EQ(*b, big);
+	CHECK_EQ(b->compare(big), 0);
+	const BigInt& ref = c;
+	CHECK_EQ(ref, big);
+}
+
+//写时复制：共享时先复制，独占时原地修改
+TEST(sharedCopyOnWrite) {
+	SharedBigInt a(BigInt(1) << 300);
+	SharedBigInt b = a;
+	b.mutate() += 1;
+	CHECK_EQ(*a, BigInt(1) << 300);
+	CHECK_EQ(*b, (BigInt(1) << 300) + 1);
+	CHECK_EQ(a.useCount(), 1);
+	CHECK_EQ(b.useCount(), 1);
+	CHECK(a != b);
+	const BigInt* address = &b.get();
+	b.mutate() *= 3;
+	CHECK(&b.get() == address);
+	CHECK_EQ(*b, ((BigInt(1) << 300) + 1) * 3);
+}
+
+TEST(sharedNaN) {
+	SharedBigInt nan, other = nan;
+	CHECK(nan->isNaN());
+	//与BigInt一致，NaN不等于任何值，包括共享的同一个NaN
+	CHECK(nan != other);
+	CHECK(SharedBigInt(BigInt(5)) == SharedBigInt(BigInt(5)));
+}
+
+TEST(sharedAcrossThreads) {
+	const BigInt m = test::randomExact(4000);
+	SharedBigInt shared(m);
+	std::vector<BigInt> results(4);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t) {
+		threads.emplace_back([&results, shared, t] {
+			SharedBigInt local = shared;
+			BigInt acc(t + 1);
+			for (int i = 0; i < 50; ++i) acc = acc * 12345 % *local;
+			results[t] = acc;
+		});
+	}
+	for (auto& thread : threads) thread.join();
+	for (int t = 0; t < 4; ++t) {
+		BigInt expected(t + 1);
+		for (int i = 0; i < 50; ++i) expected = expected * 12345 % m;
+		CHECK_EQ(results[t], expected);
+	}
+	CHECK_EQ(shared.useCount(), 1);
+}
+
+//另一个线程读完后销毁自己的拷贝，拥有者只靠计数降到1得知，不经过join；mutate必须与之前的读同步
+TEST(sharedMutateAfterReaderReleases) {
+	const BigInt big = test::randomExact(3000);
+	for (int round = 0; round < 20; ++round) {
+		SharedBigInt owner(big);
+		SharedBigInt* copy = new SharedBigInt(owner);
+		std::atomic<uint64_t> ones{ 0 };
+		std::thread reader([copy, &ones] {
+			ones.store(util::popcount(**copy), std::memory_order_relaxed);
+			delete copy;
+		});
+		while (owner.useCount() > 1) std::this_thread::yield();
+		owner.mutate() += 1;
+		CHECK_EQ(*owner, big + 1);
+		reader.join();
+		CHECK_EQ(ones.load(), util::popcount(big));
+	}
+}
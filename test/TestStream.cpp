@@ -0,0 +1,74 @@
+#include<string>
+#include<sstream>
+
+#include"test/Test.h"
+
+//块长288位，覆盖块的边界、多级合并和不足一块的尾部
+TEST(streamInputMatchesFromString) {
+	for (size_t n : { 1, 9, 287, 288, 289, 576, 864, 1152, 288 * 7 + 5, 288 * 16, 288 * 16 + 1, 100000 }) {
+		std::string digits;
+		for (size_t i = 0; i < n; ++i) digits.push_back(static_cast<char>('0' + test::rng()() % 10));
+		for (const std::string& s : { digits, "-" + digits, std::string(300, '0') + digits }) {
+			std::istringstream in(s + " rest");
+			BigInt x;
+			in >> x;
+			CHECK(in.good());
+			CHECK_EQ(x, BigInt(s));
+			std::string rest;
+			in >> rest;
+			CHECK_EQ(rest, "rest");
+		}
+	}
+	std::istringstream nines(std::string(288 * 5, '9'));
+	BigInt x;
+	nines >> x;
+	CHECK(nines.eof() && !nines.fail());
+	CHECK_EQ(x, util::pow(BigInt(10), 288 * 5) - 1);
+}
+
+TEST(streamInputStopsAndFails) {
+	std::istringstream in("  -42x 7\n123456789012345678901234567890");
+	BigInt a, b, c;
+	in >> a;
+	CHECK_EQ(a, BigInt(-42));
+	CHECK_EQ(static_cast<char>(in.get()), 'x');
+	in >> b >> c;
+	CHECK_EQ(b, BigInt(7));
+	CHECK_EQ(util::to_string(c), "123456789012345678901234567890");
+	CHECK(in.eof());
+
+	std::istringstream bad("abc");
+	BigInt d(5);
+	bad >> d;
+	CHECK(bad.fail());
+	CHECK(d.isNaN());
+	std::istringstream minus("- 1");
+	BigInt e(5);
+	minus >> e;
+	CHECK(minus.fail());
+	std::istringstream empty("");
+	BigInt f(5);
+	empty >> f;
+	CHECK(empty.fail());
+	CHECK_EQ(f, BigInt(5));
+}
+
+//读入的值覆盖原有的值，不受原来符号和长度的影响
+TEST(streamInputOverwrites) {
+	BigInt x = BigInt(0) - (BigInt(1) << 5000);
+	std::istringstream in("12 -0");
+	in >> x;
+	CHECK_EQ(x, BigInt(12));
+	in >> x;
+	CHECK_EQ(x, BigInt(0));
+	CHECK(util::sign(x));
+}
+
+TEST(streamOutput) {
+	for (int i = 0; i < 100; ++i) {
+		BigInt x = test::random(i < 90 ? 2000 : 60000, true);
+		std::ostringstream out;
+		out << x << ' ' << BigInt();
+		CHECK_EQ(out.str(), util::to_string(x) + " ");
+	}
+}
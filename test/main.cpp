@@ -0,0 +1,119 @@
+#include<iostream>
+#include<vector>
+#include<string>
+#include<cstring>
+#include<exception>
+#include<atomic>
+#include<cstdlib>
+#include<new>
+
+#include"test/Test.h"
+
+//替换全局的operator new，统计包括临时缓冲区在内的所有分配
+static std::atomic<uint64_t> global_allocations{ 0 };
+
+void* operator new(std::size_t size) {
+	global_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size ? size : 1)) return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+	std::free(p);
+}
+
+namespace test {
+	struct Registered {
+		const char* name;
+		Case run;
+	};
+
+	static std::vector<Registered>& registry() {
+		static std::vector<Registered> cases;
+		return cases;
+	}
+
+	static int failures{ 0 };
+
+	bool registerCase(const char* name, Case run) {
+		registry().push_back({ name, run });
+		return true;
+	}
+
+	void fail(const char* file, int line, const std::string& message) {
+		++failures;
+		//很长的数只输出开头，避免刷屏
+		std::cerr << file << "(" << line << "): " << message.substr(0, 400) << (message.size() > 400 ? "..." : "") << "\n";
+	}
+
+	uint64_t allocations() {
+		return global_allocations.load(std::memory_order_relaxed);
+	}
+
+	std::mt19937_64& rng() {
+		static std::mt19937_64 engine{ 20240601 };
+		return engine;
+	}
+
+	BigInt random(uint64_t bits, bool signed_) {
+		std::mt19937_64& r = rng();
+		if (bits == 0) return BigInt(0);
+		uint64_t n = r() % bits + 1;
+		//十六进制串一位4个比特，最高位单独截断
+		std::string hex;
+		int mode = static_cast<int>(r() % 4);
+		for (uint64_t i = 0; i < (n + 3) / 4; ++i) {
+			int digit = static_cast<int>(r() % 16);
+			//每8位(一个limb)换一次样式：随机、全0或全f
+			if (mode >= 2 && i % 8 == 0) mode = 2 + static_cast<int>(r() % 2);
+			if (mode == 2) digit = r() % 8 ? 0 : digit;
+			if (mode == 3) digit = r() % 8 ? 15 : digit;
+			hex.push_back("0123456789abcdef"[digit]);
+		}
+		if (n % 4) hex[0] = "0123456789abcdef"[(r() % 16) & ((1u << (n % 4)) - 1)];
+		BigInt ret = util::from_string(hex, 16);
+		if (signed_ && (r() & 1)) ret = -ret;
+		return ret;
+	}
+
+	std::vector<limbs::limb_t> randomLimbs(uint32_t n) {
+		std::mt19937_64& r = rng();
+		std::vector<limbs::limb_t> ret(n);
+		int mode = static_cast<int>(r() % 3);
+		for (auto& x : ret) {
+			if (r() % 16 == 0) mode = static_cast<int>(r() % 3);
+			x = mode == 0 ? static_cast<limbs::limb_t>(r()) : (mode == 1 ? 0 : 0xffffffffu);
+		}
+		if (n > 0 && ret[n - 1] == 0) ret[n - 1] = static_cast<limbs::limb_t>(r()) | 1;
+		return ret;
+	}
+
+	BigInt randomExact(uint64_t bits) {
+		BigInt ret = random(bits);
+		util::set_bit(ret, bits - 1);
+		return ret;
+	}
+}
+
+//不带参数时运行全部用例，否则只运行名字包含参数的用例
+int main(int argc, char* argv[]) {
+	int run{ 0 };
+	for (const auto& c : test::registry()) {
+		if (argc > 1 && std::strstr(c.name, argv[1]) == nullptr) continue;
+		int before = test::failures;
+		try {
+			c.run();
+		}
+		catch (const std::exception& e) {
+			test::fail(c.name, 0, std::string("unexpected exception: ") + e.what());
+		}
+		++run;
+		if (test::failures != before) std::cerr << "FAILED " << c.name << "\n";
+	}
+	std::cout << run << " cases, " << test::failures << " failures\n";
+	return test::failures == 0 ? 0 : 1;
+}